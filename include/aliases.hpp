@@ -5,32 +5,8 @@
 #ifndef MFC_INCLUDE_ALIASES_HPP_
 #define MFC_INCLUDE_ALIASES_HPP_
 
+#include <array>
 #include <vector>
-#include <unordered_map>
-
-/**
- * A function that will produce a hash for an array of 4 values.
- */
-struct tri_hasher {
-
-  std::size_t operator()(const std::array<size_t, 3> &arr) const {
-    std::hash<size_t> size_t_hash;
-    return size_t_hash(arr[0]) ^ size_t_hash(arr[1]) ^ size_t_hash(arr[2]);
-  }
-
-};
-
-/**
- * A function that will produce a hash for an array of 2 values.
- */
-struct edge_hasher {
-
-  std::size_t operator()(const std::array<size_t, 2> &arr) const {
-    std::hash<size_t> size_t_hash;
-    return size_t_hash(arr[0]) ^ size_t_hash(arr[1]);
-  }
-
-};
 
 // Vertex.
 typedef std::array<double, 3> vert;
@@ -41,9 +17,6 @@ typedef std::vector<vert> v_list;
 // Vertex index list.
 typedef std::vector<size_t> vi_list;
 
-// Vertex to vertices map.
-typedef std::unordered_map<size_t, vi_list> v_to_vs_list;
-
 // Edge.
 typedef std::array<size_t, 2> edge;
 
@@ -71,21 +44,9 @@ typedef std::vector<tet> tet_list;
 // Tetrahedron index list.
 typedef std::vector<size_t> teti_list;
 
-// Tetrahedron to tetrahedrons map.
-typedef std::unordered_map<size_t, teti_list> tet_to_tets_map;
-
 // Sub-mesh index list.
 typedef std::vector<size_t> sm_list;
 
-// Sorted triangle to tets map.
-typedef std::unordered_map<tri, teti_list, tri_hasher> stri_to_tets_map;
-
-// Sorted edge to tets map.
-typedef std::unordered_map<edge, edgei_list, edge_hasher> sedge_to_tets_map;
-
-// Sorted triangle to triangle map.
-typedef std::unordered_map<tri, tri, tri_hasher> stri_to_tri_map;
-
 // Field vector.
 typedef std::array<double, 3> fv;
 
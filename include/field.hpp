@@ -5,14 +5,48 @@
 #ifndef MFC_INCLUDE_FIELD_HPP_
 #define MFC_INCLUDE_FIELD_HPP_
 
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <span>
+#include <string>
 #include <utility>
-
-#include <utility>
+#include <vector>
 
 #include "aliases.hpp"
 
+class FieldListException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  FieldListException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
 /**
  * Holds a field - which is a collection of vectors associated with vertices.
+ * A field is a view of a run of vectors in a (shared) storage block: either a
+ * block of its own, or a slice of a field list's contiguous block. Copying a
+ * field copies its vectors in to a block of its own, so that a copy never
+ * writes through to the field (or field list) that it was copied from; moving
+ * a field keeps its block.
  */
 class Field {
 
@@ -23,7 +57,7 @@ class Field {
    * @param n the number of vectors.
    */
   explicit Field(size_t n) :
-      _vectors{n} {}
+      Field(std::string(), n) {}
 
   /**
    * Create a new Field object with `n` vectors and a annotation.
@@ -32,14 +66,15 @@ class Field {
    */
   Field(std::string annotation, size_t n) :
       _annotation{std::move(annotation)},
-      _vectors{n} {}
+      _storage{std::make_shared<fv_list>(n)},
+      _size{n} {}
 
   /**
    * Create a new Field object from a list of vectors, with a blank annotation.
    * @param vectors the vectors of the field.
    */
   explicit Field(fv_list vectors) :
-      _vectors{std::move(vectors)} {}
+      Field(std::string(), std::move(vectors)) {}
 
   /**
    * Create a new Field object from a list list of vectors with a annotation.
@@ -48,21 +83,59 @@ class Field {
    */
   Field(std::string annotation, fv_list vectors) :
       _annotation{std::move(annotation)},
-      _vectors{std::move(vectors)} {}
+      _size{vectors.size()} {
+
+    _storage = std::make_shared<fv_list>(std::move(vectors));
+
+  }
+
+  /**
+   * Create a deep copy of a field.
+   * @param other the field to copy.
+   */
+  Field(const Field &other) :
+      _annotation{other._annotation},
+      _storage{std::make_shared<fv_list>(other.vectors().begin(), other.vectors().end())},
+      _size{other._size} {}
+
+  Field(Field &&other) noexcept = default;
+
+  /**
+   * Replace this field with a deep copy of another.
+   * @param other the field to copy.
+   */
+  Field &
+  operator=(const Field &other) {
+
+    if (this != &other) *this = Field(other);
+
+    return *this;
+
+  }
+
+  Field &
+  operator=(Field &&other) noexcept = default;
 
   /**
    * Retrieve a const list of vectors.
    * @return the vectors comprising the field.
    */
-  [[nodiscard]] const fv_list &
-  vectors() const { return _vectors; }
+  [[nodiscard]] std::span<const fv>
+  vectors() const { return {_storage->data() + _offset, _size}; }
 
   /**
    * Retrieve a list of vectors.
    * @return the vectors comprising the field.
    */
-  fv_list &
-  vectors() { return _vectors; }
+  std::span<fv>
+  vectors() { return {_storage->data() + _offset, _size}; }
+
+  /**
+   * Retrieve the number of vectors.
+   * @return the number of vectors.
+   */
+  [[nodiscard]] size_t
+  size() const { return _size; }
 
   /**
    * Retrieve the annotation of the field.
@@ -73,16 +146,78 @@ class Field {
 
  private:
 
+  friend class FieldList;
+
+  /**
+   * Create a view of a slice of a storage block.
+   * @param annotation the annotation of the field.
+   * @param storage the storage block.
+   * @param offset the index of the field's first vector in the block.
+   * @param size the number of vectors.
+   */
+  Field(std::string annotation, std::shared_ptr<fv_list> storage, size_t offset, size_t size) :
+      _annotation{std::move(annotation)},
+      _storage{std::move(storage)},
+      _offset{offset},
+      _size{size} {}
+
   // The field's annotation.
   std::string _annotation;
 
-  // The field's vectors.
-  fv_list _vectors;
+  // The block holding the field's vectors.
+  std::shared_ptr<fv_list> _storage;
+
+  // The index of the field's first vector in the block.
+  size_t _offset = 0;
+
+  // The number of vectors.
+  size_t _size = 0;
+
+};
+
+/**
+ * A view of the vectors of one vertex across every field of a field list.
+ */
+class FieldTrajectory {
+
+ public:
+
+  /**
+   * Create a view.
+   * @param fields the fields.
+   * @param vertex the vertex.
+   */
+  FieldTrajectory(const std::vector<Field> &fields, size_t vertex) :
+      _fields(&fields), _vertex(vertex) {}
+
+  /**
+   * Retrieve the number of fields.
+   */
+  [[nodiscard]] size_t
+  size() const { return _fields->size(); }
+
+  /**
+   * Retrieve the vector of the vertex in a field.
+   * @param i the field index.
+   */
+  [[nodiscard]] const fv &
+  operator[](size_t i) const { return (*_fields)[i].vectors()[_vertex]; }
+
+ private:
+
+  const std::vector<Field> *_fields;
+
+  size_t _vertex;
 
 };
 
 /**
- * Holds a collection of fields.
+ * Holds a collection of fields. The fields are either added one at a time,
+ * each with its own storage, or allocated in one go as a single contiguous
+ * [n_fields, n_vertices, 3] block that every field is a slice of. Only a
+ * contiguous list can hand out the whole block, e.g. for a single HDF5 write.
+ * Copying a field list copies its vectors (in to one block, if the list is
+ * contiguous).
  */
 class FieldList {
 
@@ -93,6 +228,64 @@ class FieldList {
    */
   FieldList() = default;
 
+  /**
+   * Create a deep copy of a field list.
+   * @param other the field list to copy.
+   */
+  FieldList(const FieldList &other) {
+
+    if (other.contiguous()) {
+      _fields = std::move(other.packed()._fields);
+    } else {
+      _fields = other._fields;
+    }
+
+  }
+
+  FieldList(FieldList &&other) noexcept = default;
+
+  /**
+   * Replace this field list with a deep copy of another.
+   * @param other the field list to copy.
+   */
+  FieldList &
+  operator=(const FieldList &other) {
+
+    if (this != &other) *this = FieldList(other);
+
+    return *this;
+
+  }
+
+  FieldList &
+  operator=(FieldList &&other) noexcept = default;
+
+  /**
+   * Create a field list with a contiguous block of zero vectors, one field
+   * per annotation.
+   * @param annotations the annotations of the fields.
+   * @param n_vertices the number of vectors of each field.
+   */
+  FieldList(const std::vector<std::string> &annotations, size_t n_vertices) {
+
+    auto storage = std::make_shared<fv_list>(annotations.size() * n_vertices);
+
+    _fields.reserve(annotations.size());
+    for (size_t i = 0; i < annotations.size(); ++i) {
+      _fields.push_back(Field(annotations[i], storage, i * n_vertices, n_vertices));
+    }
+
+  }
+
+  /**
+   * Create a field list with a contiguous block of zero vectors and blank
+   * annotations.
+   * @param n_fields the number of fields.
+   * @param n_vertices the number of vectors of each field.
+   */
+  FieldList(size_t n_fields, size_t n_vertices) :
+      FieldList(std::vector<std::string>(n_fields), n_vertices) {}
+
   /**
    * Retrieve the fields associated with this field list.
    * @return the fields in this field list.
@@ -121,6 +314,92 @@ class FieldList {
   [[nodiscard]] size_t
   n_fields() const { return _fields.size(); }
 
+  /**
+   * Retrieve true if the fields are consecutive, equally sized slices of one
+   * storage block.
+   */
+  [[nodiscard]] bool
+  contiguous() const {
+
+    if (_fields.empty()) return false;
+
+    const Field &first = _fields[0];
+    for (size_t i = 0; i < _fields.size(); ++i) {
+      const Field &field = _fields[i];
+      if (field._storage != first._storage
+          || field._size != first._size
+          || field._offset != first._offset + i * first._size) return false;
+    }
+
+    return true;
+
+  }
+
+  /**
+   * Retrieve the vectors of every field as one [n_fields * n_vertices] run.
+   * @return the vectors, or an empty span if the list is not contiguous.
+   */
+  [[nodiscard]] std::span<const fv>
+  block() const {
+
+    if (!contiguous()) return {};
+
+    return {_fields[0]._storage->data() + _fields[0]._offset, _fields.size() * _fields[0]._size};
+
+  }
+
+  /**
+   * Retrieve the vectors of every field as one [n_fields * n_vertices] run,
+   * e.g. to read many fields with a single HDF5 read.
+   * @return the vectors, or an empty span if the list is not contiguous.
+   */
+  std::span<fv>
+  block() {
+
+    if (!contiguous()) return {};
+
+    return {_fields[0]._storage->data() + _fields[0]._offset, _fields.size() * _fields[0]._size};
+
+  }
+
+  /**
+   * Retrieve a copy of this field list whose fields share one contiguous
+   * block (the annotations are kept).
+   * @return the contiguous field list.
+   */
+  [[nodiscard]] FieldList
+  packed() const {
+
+    if (_fields.empty()) return {};
+
+    std::vector<std::string> annotations;
+    for (const auto &field : _fields) annotations.push_back(field.annotation());
+
+    size_t n_vertices = _fields[0].size();
+    for (const auto &field : _fields) {
+      if (field.size() != n_vertices) {
+        throw FieldListException("Fields of different sizes cannot be packed.");
+      }
+    }
+
+    FieldList result(annotations, n_vertices);
+    for (size_t i = 0; i < _fields.size(); ++i) {
+      std::copy(_fields[i].vectors().begin(), _fields[i].vectors().end(),
+                result._fields[i].vectors().begin());
+    }
+
+    return result;
+
+  }
+
+  /**
+   * Retrieve the vectors of a vertex across every field.
+   * @param vertex the vertex.
+   * @return the view.
+   */
+  [[nodiscard]] FieldTrajectory
+  trajectory(size_t vertex) const { return {_fields, vertex}; }
+
  private:
 
   std::vector<Field> _fields;
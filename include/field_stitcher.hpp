@@ -0,0 +1,218 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_FIELD_STITCHER_HPP_
+#define MFC_INCLUDE_FIELD_STITCHER_HPP_
+
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include <H5Cpp.h>
+
+#include "hdf5_links.hpp"
+#include "precision.hpp"
+
+/**
+ * Object that will be thrown on field stitching exception.
+ */
+class FieldStitcherException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  FieldStitcherException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * What a stitched file holds: the number of steps and vertices, and the
+ * precision of the fields.
+ */
+struct StitchSummary {
+
+  // Number of steps (source files).
+  size_t n_steps = 0;
+
+  // Number of vertices of the shared mesh.
+  size_t n_vertices = 0;
+
+  // The precision of the source fields.
+  Precision precision = Precision::DOUBLE;
+
+};
+
+/**
+ * Stitches the `/fields/field0' of many .mmf files that share a mesh (e.g.
+ * the runs of a parameter sweep) in to one time series file, without copying
+ * any data:
+ * - `/mesh' is an external link to the first file's mesh,
+ * - `/fields/series' is an [n_steps, n_vertices, 3] HDF5 virtual data set
+ *   whose i-th slice maps on to the i-th file's `/fields/field0/vectors',
+ * - `/fields/field<i>' is an external link to the i-th file's
+ *   `/fields/field0', so the result is also a regular .mmf file.
+ * The sources are referred to by their paths relative to the stitched file
+ * and must stay in place.
+ */
+class FieldStitcher {
+
+ public:
+
+  // The path of the virtual series data set.
+  static constexpr const char *SERIES = "/fields/series";
+
+  /**
+   * Stitch a list of .mmf files.
+   * @param file_name the name of the stitched file.
+   * @param sources the names of the source files, in step order.
+   * @return a summary of the stitched file.
+   */
+  static StitchSummary
+  stitch(const std::string &file_name, const std::vector<std::string> &sources) {
+
+    if (sources.empty()) {
+      throw FieldStitcherException("No files to stitch.");
+    }
+
+    StitchSummary summary = check_sources(sources);
+
+    H5::H5File file(file_name, H5F_ACC_TRUNC);
+
+    link(file, "/mesh", sources.front(), "/mesh");
+
+    H5::Group grp_fields(file.createGroup("/fields"));
+
+    // Map each slice of the series on to a source's field.
+    hsize_t dims[3] = {summary.n_steps, summary.n_vertices, 3};
+    H5::DataSpace dsp_series(3, dims);
+
+    hsize_t dims_source[2] = {summary.n_vertices, 3};
+    H5::DataSpace dsp_source(2, dims_source);
+
+    H5::DSetCreatPropList plist;
+    for (size_t i = 0; i < sources.size(); ++i) {
+
+      hsize_t start[3] = {i, 0, 0};
+      hsize_t count[3] = {1, summary.n_vertices, 3};
+      dsp_series.selectHyperslab(H5S_SELECT_SET, count, start);
+
+      std::string source = link_target(file, sources[i]);
+      if (H5Pset_virtual(plist.getId(), dsp_series.getId(), source.c_str(), "/fields/field0/vectors",
+                         dsp_source.getId()) < 0) {
+        throw FieldStitcherException("Could not map step " + std::to_string(i) + " on to '" + source + "'.");
+      }
+
+    }
+
+    dsp_series.selectAll();
+    file.createDataSet(SERIES, precision_type(summary.precision), dsp_series, plist);
+
+    // And link each step's field, as in a regular file.
+    for (size_t i = 0; i < sources.size(); ++i) {
+      link(file, "/fields/field" + std::to_string(i), sources[i], "/fields/field0");
+    }
+
+    return summary;
+
+  }
+
+ private:
+
+  /**
+   * Check that every source has a `/fields/field0/vectors' data set over the
+   * same number of vertices, and (where tagged) the same mesh as the first.
+   * @param sources the names of the source files.
+   * @return the summary of the series.
+   */
+  static StitchSummary
+  check_sources(const std::vector<std::string> &sources) {
+
+    StitchSummary summary;
+    summary.n_steps = sources.size();
+
+    uint64_t first_hash = 0;
+    bool first_tagged = false;
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+
+      H5::H5File file(sources[i], H5F_ACC_RDONLY);
+
+      if (H5Lexists(file.getId(), "/fields", H5P_DEFAULT) <= 0
+          || H5Lexists(file.getId(), "/fields/field0", H5P_DEFAULT) <= 0
+          || H5Lexists(file.getId(), "/fields/field0/vectors", H5P_DEFAULT) <= 0) {
+        throw FieldStitcherException("'" + sources[i] + "' has no '/fields/field0/vectors'.");
+      }
+
+      H5::DataSet data_set = file.openDataSet("/fields/field0/vectors");
+      hsize_t dims[2] = {0, 0};
+      data_set.getSpace().getSimpleExtentDims(dims, nullptr);
+
+      H5::Group grp_mesh = file.openGroup("/mesh");
+      bool tagged = grp_mesh.attrExists("hash");
+      uint64_t hash = 0;
+      if (tagged) grp_mesh.openAttribute("hash").read(H5::PredType::NATIVE_UINT64, &hash);
+
+      if (i == 0) {
+        summary.n_vertices = dims[0];
+        summary.precision = data_set.getDataType().getSize() == 4 ? Precision::SINGLE : Precision::DOUBLE;
+        first_hash = hash;
+        first_tagged = tagged;
+        continue;
+      }
+
+      if (dims[0] != summary.n_vertices || dims[1] != 3) {
+        throw FieldStitcherException(
+            "'" + sources[i] + "' has " + std::to_string(dims[0]) + " field vectors, expected "
+                + std::to_string(summary.n_vertices) + ".");
+      }
+
+      if (tagged && first_tagged && hash != first_hash) {
+        throw FieldStitcherException("'" + sources[i] + "' has a different mesh to '" + sources[0] + "'.");
+      }
+
+    }
+
+    return summary;
+
+  }
+
+  /**
+   * Create an external link.
+   * @param file the HDF5 file handle.
+   * @param name the name of the link.
+   * @param target_file the name of the file linked to.
+   * @param target_path the path of the object linked to.
+   */
+  static void
+  link(H5::H5File &file, const std::string &name, const std::string &target_file, const std::string &target_path) {
+
+    std::string target = link_target(file, target_file);
+
+    if (H5Lcreate_external(target.c_str(), target_path.c_str(), file.getId(), name.c_str(),
+                           H5P_DEFAULT, H5P_DEFAULT) < 0) {
+      throw FieldStitcherException("Could not link '" + name + "' to '" + target + ":" + target_path + "'.");
+    }
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_FIELD_STITCHER_HPP_
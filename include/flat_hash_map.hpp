@@ -0,0 +1,439 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_FLAT_HASH_MAP_HPP_
+#define MFC_INCLUDE_FLAT_HASH_MAP_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Mix the bits of a 64-bit value (the MurmurHash3 finalizer), every input bit
+ * affects every output bit.
+ * @param x the value.
+ * @return the mixed value.
+ */
+inline uint64_t
+mix64(uint64_t x) {
+
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+
+  return x;
+
+}
+
+/**
+ * A hash for integers and fixed size arrays of integers. Unlike combining
+ * `std::hash' values (the identity for integers) with XOR, permutations and
+ * structured index patterns do not collide.
+ */
+struct IntegerKeyHasher {
+
+  template<typename T>
+  requires std::is_integral_v<T>
+  size_t
+  operator()(T key) const {
+    return mix64((uint64_t) key + 0x9e3779b97f4a7c15ULL);
+  }
+
+  template<typename T, size_t N>
+  requires std::is_integral_v<T>
+  size_t
+  operator()(const std::array<T, N> &key) const {
+    uint64_t h = 0x9e3779b97f4a7c15ULL * N;
+    for (const auto &k : key) {
+      h = mix64(h ^ ((uint64_t) k + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2)));
+    }
+    return h;
+  }
+
+};
+
+/**
+ * A hash map with open addressing and linear probing. Keys, values and one
+ * metadata byte per slot are held in three flat arrays; the metadata byte of
+ * an occupied slot stores 7 bits of the key's hash, so most non-matching
+ * slots are rejected without touching the keys (as in Swiss tables).
+ *
+ * As well as the usual single threaded interface, `concurrent_update' lets
+ * several threads insert in to (and update the values of) a map whose
+ * capacity was reserved beforehand: slots are claimed, and values updated,
+ * under a per-slot lock held in the metadata byte.
+ */
+template<typename Key, typename Value, typename Hash = IntegerKeyHasher>
+class FlatHashMap {
+
+ public:
+
+  /**
+   * Create an empty map.
+   */
+  FlatHashMap() = default;
+
+  /**
+   * Retrieve the number of entries.
+   */
+  [[nodiscard]] size_t
+  size() const { return _size; }
+
+  /**
+   * Retrieve true if the map is empty.
+   */
+  [[nodiscard]] bool
+  empty() const { return _size == 0; }
+
+  /**
+   * Retrieve the number of slots.
+   */
+  [[nodiscard]] size_t
+  capacity() const { return _ctrl.size(); }
+
+  /**
+   * Remove all entries, the capacity is kept.
+   */
+  void
+  clear() {
+
+    std::fill(_ctrl.begin(), _ctrl.end(), EMPTY);
+    std::fill(_values.begin(), _values.end(), Value{});
+    _size = 0;
+
+  }
+
+  /**
+   * Make sure that `n' entries fit without growing the map.
+   * @param n the number of entries.
+   */
+  void
+  reserve(size_t n) {
+
+    size_t capacity = 16;
+    while (capacity * MAX_LOAD_NUM < n * MAX_LOAD_DEN) capacity *= 2;
+
+    if (capacity > _ctrl.size()) rehash(capacity);
+
+  }
+
+  /**
+   * Retrieve the value of a key, inserting a default value if it is missing.
+   * @param key the key.
+   * @return the value.
+   */
+  Value &
+  operator[](const Key &key) {
+
+    if ((_size + 1) * MAX_LOAD_DEN > _ctrl.size() * MAX_LOAD_NUM) {
+      rehash(std::max<size_t>(16, 2 * _ctrl.size()));
+    }
+
+    size_t h = _hash(key);
+    uint8_t tag = tag_of(h);
+
+    for (size_t i = h & _mask;; i = (i + 1) & _mask) {
+      if (_ctrl[i] == EMPTY) {
+        _ctrl[i] = tag;
+        _keys[i] = key;
+        _size++;
+        return _values[i];
+      }
+      if (_ctrl[i] == tag && _keys[i] == key) return _values[i];
+    }
+
+  }
+
+  /**
+   * Find the value of a key.
+   * @param key the key.
+   * @return a pointer to the value, or nullptr if the key is missing.
+   */
+  [[nodiscard]] const Value *
+  find(const Key &key) const {
+
+    if (_size == 0) return nullptr;
+
+    size_t h = _hash(key);
+    uint8_t tag = tag_of(h);
+
+    for (size_t i = h & _mask;; i = (i + 1) & _mask) {
+      if (_ctrl[i] == EMPTY) return nullptr;
+      if (_ctrl[i] == tag && _keys[i] == key) return &_values[i];
+    }
+
+  }
+
+  /**
+   * Find the value of a key.
+   * @param key the key.
+   * @return a pointer to the value, or nullptr if the key is missing.
+   */
+  Value *
+  find(const Key &key) {
+
+    return const_cast<Value *>(std::as_const(*this).find(key));
+
+  }
+
+  /**
+   * Retrieve true if the map holds a key.
+   */
+  [[nodiscard]] bool
+  contains(const Key &key) const { return find(key) != nullptr; }
+
+  /**
+   * Look up many keys at once. All the hashes are computed, and the home
+   * slots prefetched, before any slot is probed, so that the cache misses of
+   * independent lookups overlap.
+   * @param keys the keys.
+   * @param values the values (nullptr for missing keys), same size as keys.
+   */
+  void
+  find_batch(std::span<const Key> keys, std::span<const Value *> values) const {
+
+    constexpr size_t block = 32;
+    std::array<size_t, block> hashes{};
+
+    for (size_t begin = 0; begin < keys.size(); begin += block) {
+
+      size_t end = std::min(keys.size(), begin + block);
+
+      for (size_t i = begin; i < end; ++i) {
+        hashes[i - begin] = _hash(keys[i]);
+        if (!_ctrl.empty()) {
+          __builtin_prefetch(&_ctrl[hashes[i - begin] & _mask]);
+          __builtin_prefetch(&_keys[hashes[i - begin] & _mask]);
+        }
+      }
+
+      for (size_t i = begin; i < end; ++i) {
+        values[i] = find_hashed(keys[i], hashes[i - begin]);
+      }
+
+    }
+
+  }
+
+  /**
+   * Insert or update an entry from several threads at once: `fn(value)' is
+   * called with exclusive access to the key's value (default constructed if
+   * the key is new). The capacity must have been reserved for all of the
+   * entries before the concurrent phase starts; an insert that would take the
+   * map past its maximum load throws std::length_error (so that lookups of
+   * missing keys always reach an empty slot). If `fn' throws, the slot is
+   * released again (and a new entry removed) before the exception propagates.
+   * @param key the key.
+   * @param fn the function that updates the value.
+   */
+  template<typename Fn>
+  void
+  concurrent_update(const Key &key, Fn &&fn) {
+
+    size_t h = _hash(key);
+    uint8_t tag = tag_of(h);
+
+    for (size_t i = h & _mask, n = 0; n < _ctrl.size(); i = (i + 1) & _mask, ++n) {
+
+      std::atomic_ref<uint8_t> ctrl(_ctrl[i]);
+
+      while (true) {
+
+        uint8_t state = ctrl.load(std::memory_order_acquire);
+
+        if (state == EMPTY) {
+          // Count the entry, then try to claim the slot.
+          if (!claim_entry()) {
+            throw std::length_error("FlatHashMap maximum load reached, reserve first.");
+          }
+          if (!ctrl.compare_exchange_weak(state, LOCKED, std::memory_order_acquire)) {
+            std::atomic_ref<size_t>(_size).fetch_sub(1, std::memory_order_relaxed);
+            continue;
+          }
+          SlotGuard guard{*this, i, tag, true};
+          _keys[i] = key;
+          fn(_values[i]);
+          guard.done = true;
+          return;
+        }
+
+        if (state == LOCKED) {
+          std::this_thread::yield();
+          continue;
+        }
+
+        if (state != tag) break;
+
+        // Same tag, lock the slot to compare the key and update the value.
+        if (!ctrl.compare_exchange_weak(state, LOCKED, std::memory_order_acquire)) {
+          continue;
+        }
+        SlotGuard guard{*this, i, tag, false};
+        if (_keys[i] != key) break;
+        fn(_values[i]);
+        guard.done = true;
+        return;
+
+      }
+
+    }
+
+    throw std::length_error("FlatHashMap capacity exhausted, reserve first.");
+
+  }
+
+  /**
+   * Call `fn(key, value)' for each entry.
+   */
+  template<typename Fn>
+  void
+  for_each(Fn &&fn) const {
+
+    for (size_t i = 0; i < _ctrl.size(); ++i) {
+      if (_ctrl[i] & FULL_BIT) fn(_keys[i], _values[i]);
+    }
+
+  }
+
+ private:
+
+  // Metadata byte values: empty, locked, or FULL_BIT | 7 bits of hash.
+  static constexpr uint8_t EMPTY = 0x00;
+  static constexpr uint8_t LOCKED = 0x01;
+  static constexpr uint8_t FULL_BIT = 0x80;
+
+  // Maximum load factor (7/8).
+  static constexpr size_t MAX_LOAD_NUM = 7;
+  static constexpr size_t MAX_LOAD_DEN = 8;
+
+  Hash _hash;
+
+  std::vector<uint8_t> _ctrl;
+
+  std::vector<Key> _keys;
+
+  std::vector<Value> _values;
+
+  size_t _mask = 0;
+
+  size_t _size = 0;
+
+  /**
+   * Releases a slot locked by `concurrent_update' when it goes out of scope:
+   * the slot gets its tag back, unless it was claimed for a new entry that
+   * was not completed (the update function threw), which is removed again.
+   */
+  struct SlotGuard {
+
+    FlatHashMap &map;
+
+    size_t slot;
+
+    uint8_t tag;
+
+    bool inserted;
+
+    bool done = false;
+
+    ~SlotGuard() {
+
+      std::atomic_ref<uint8_t> ctrl(map._ctrl[slot]);
+
+      if (inserted && !done) {
+        map._values[slot] = Value{};
+        std::atomic_ref<size_t>(map._size).fetch_sub(1, std::memory_order_relaxed);
+        ctrl.store(EMPTY, std::memory_order_release);
+        return;
+      }
+
+      ctrl.store(tag, std::memory_order_release);
+
+    }
+
+  };
+
+  /**
+   * Count a new entry of `concurrent_update', if it fits within the maximum
+   * load of the reserved capacity.
+   * @return true if the entry was counted.
+   */
+  bool
+  claim_entry() {
+
+    std::atomic_ref<size_t> size(_size);
+
+    size_t n = size.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (n * MAX_LOAD_DEN > _ctrl.size() * MAX_LOAD_NUM) {
+      size.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    return true;
+
+  }
+
+  /**
+   * Retrieve the metadata tag of a hash, the low bits pick the slot so the
+   * tag uses the high bits.
+   */
+  static uint8_t
+  tag_of(size_t h) { return FULL_BIT | (uint8_t) (h >> 57); }
+
+  /**
+   * Find the value of a key given its hash.
+   */
+  const Value *
+  find_hashed(const Key &key, size_t h) const {
+
+    if (_size == 0) return nullptr;
+
+    uint8_t tag = tag_of(h);
+
+    for (size_t i = h & _mask;; i = (i + 1) & _mask) {
+      if (_ctrl[i] == EMPTY) return nullptr;
+      if (_ctrl[i] == tag && _keys[i] == key) return &_values[i];
+    }
+
+  }
+
+  /**
+   * Move all entries to a table with a new number of slots.
+   * @param capacity the new number of slots (a power of two).
+   */
+  void
+  rehash(size_t capacity) {
+
+    std::vector<uint8_t> ctrl(capacity, EMPTY);
+    std::vector<Key> keys(capacity);
+    std::vector<Value> values(capacity);
+    size_t mask = capacity - 1;
+
+    for (size_t i = 0; i < _ctrl.size(); ++i) {
+      if (!(_ctrl[i] & FULL_BIT)) continue;
+      size_t j = _hash(_keys[i]) & mask;
+      while (ctrl[j] != EMPTY) j = (j + 1) & mask;
+      ctrl[j] = _ctrl[i];
+      keys[j] = std::move(_keys[i]);
+      values[j] = std::move(_values[i]);
+    }
+
+    _ctrl.swap(ctrl);
+    _keys.swap(keys);
+    _values.swap(values);
+    _mask = mask;
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_FLAT_HASH_MAP_HPP_
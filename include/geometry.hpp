@@ -0,0 +1,171 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_GEOMETRY_HPP_
+#define MFC_INCLUDE_GEOMETRY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "aliases.hpp"
+
+/**
+ * Subtract two vectors.
+ */
+inline vert
+sub(const vert &a, const vert &b) {
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+/**
+ * Add two vectors.
+ */
+inline vert
+add(const vert &a, const vert &b) {
+  return {a[0] + b[0], a[1] + b[1], a[2] + b[2]};
+}
+
+/**
+ * Scale a vector.
+ */
+inline vert
+scale(double s, const vert &a) {
+  return {s * a[0], s * a[1], s * a[2]};
+}
+
+/**
+ * The dot product of two vectors.
+ */
+inline double
+dot(const vert &a, const vert &b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * The cross product of two vectors.
+ */
+inline vert
+cross(const vert &a, const vert &b) {
+  return {
+      a[1] * b[2] - a[2] * b[1],
+      a[2] * b[0] - a[0] * b[2],
+      a[0] * b[1] - a[1] * b[0]
+  };
+}
+
+/**
+ * The length of a vector.
+ */
+inline double
+norm(const vert &a) {
+  return std::sqrt(dot(a, a));
+}
+
+/**
+ * An axis aligned bounding box.
+ */
+struct BoundingBox {
+
+  vert min{
+      std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::max()
+  };
+
+  vert max{
+      std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::lowest()
+  };
+
+  /**
+   * Grow the box so that it contains a point.
+   * @param p the point.
+   */
+  void
+  extend(const vert &p) {
+    for (size_t i = 0; i < 3; ++i) {
+      min[i] = std::min(min[i], p[i]);
+      max[i] = std::max(max[i], p[i]);
+    }
+  }
+
+  /**
+   * Grow the box so that it contains another box.
+   * @param other the other box.
+   */
+  void
+  extend(const BoundingBox &other) {
+    extend(other.min);
+    extend(other.max);
+  }
+
+};
+
+/**
+ * Retrieve the six times the signed volume of a tetrahedron, positive if
+ * (b - a, c - a, d - a) is right handed.
+ * @param a the first vertex.
+ * @param b the second vertex.
+ * @param c the third vertex.
+ * @param d the fourth vertex.
+ * @return six times the signed volume.
+ */
+inline double
+tet_signed_volume6(const vert &a, const vert &b, const vert &c, const vert &d) {
+  return dot(sub(b, a), cross(sub(c, a), sub(d, a)));
+}
+
+/**
+ * Compute the barycentric coordinates of a point with respect to a
+ * tetrahedron.
+ * @param a the first vertex.
+ * @param b the second vertex.
+ * @param c the third vertex.
+ * @param d the fourth vertex.
+ * @param p the point.
+ * @param bary the barycentric coordinates (weights of a, b, c and d).
+ * @return false if the tetrahedron is degenerate, otherwise true.
+ */
+inline bool
+barycentric(const vert &a,
+            const vert &b,
+            const vert &c,
+            const vert &d,
+            const vert &p,
+            std::array<double, 4> &bary) {
+
+  double v6 = tet_signed_volume6(a, b, c, d);
+
+  if (v6 == 0.0) return false;
+
+  double inv = 1.0 / v6;
+
+  bary[1] = tet_signed_volume6(a, p, c, d) * inv;
+  bary[2] = tet_signed_volume6(a, b, p, d) * inv;
+  bary[3] = tet_signed_volume6(a, b, c, p) * inv;
+  bary[0] = 1.0 - bary[1] - bary[2] - bary[3];
+
+  return true;
+
+}
+
+/**
+ * Retrieve the bounding box of a mesh's vertices.
+ * @param vcl the vertex list.
+ * @return the bounding box.
+ */
+inline BoundingBox
+bounding_box(const v_list &vcl) {
+
+  BoundingBox box;
+  for (const auto &v : vcl) box.extend(v);
+
+  return box;
+
+}
+
+#endif //MFC_INCLUDE_GEOMETRY_HPP_
@@ -0,0 +1,396 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_GEOMETRY_CACHE_HPP_
+#define MFC_INCLUDE_GEOMETRY_CACHE_HPP_
+
+#include <array>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <H5Cpp.h>
+
+#include "aliases.hpp"
+#include "field.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "parallel.hpp"
+
+class GeometryCacheException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  GeometryCacheException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * The per-tetrahedron geometry that derivative kernels need: the signed
+ * volume, and the gradients of the four linear shape functions (the 3x4
+ * B-matrix). Everything is stored as structure of arrays, one array for the
+ * volumes and one for each of the 12 B-matrix entries, so that kernels are a
+ * gather of the vertex values followed by multiply-adds over contiguous
+ * arrays.
+ */
+class GeometryCache {
+
+ public:
+
+  // Location of the cache in a micromagnetic model file. It is kept out of
+  // `/mesh', which may be an external link in to a shared, immutable mesh
+  // store entry.
+  static constexpr const char *GROUP = "/geometry";
+
+  // Location of the cache in files written before it moved.
+  static constexpr const char *LEGACY_GROUP = "/mesh/geometry";
+
+  /**
+   * Compute the geometry of a mesh.
+   * @param mesh the mesh.
+   */
+  explicit GeometryCache(const Mesh &mesh) {
+
+    const auto &vcl = mesh.vcl();
+    const auto &til = mesh.til();
+
+    size_t n = til.size();
+
+    _volumes.resize(n);
+    for (auto &b : _b) b.resize(n);
+
+    parallel_for(n, [&](size_t begin, size_t end) {
+      for (size_t t = begin; t < end; ++t) {
+
+        const vert &a = vcl[til[t][0]];
+        vert e1 = sub(vcl[til[t][1]], a);
+        vert e2 = sub(vcl[til[t][2]], a);
+        vert e3 = sub(vcl[til[t][3]], a);
+
+        // The rows of the inverse Jacobian are the gradients of the shape
+        // functions of vertices 1, 2 and 3.
+        vert c23 = cross(e2, e3);
+        vert c31 = cross(e3, e1);
+        vert c12 = cross(e1, e2);
+        double det = dot(e1, c23);
+        double inv = det != 0.0 ? 1.0 / det : 0.0;
+
+        _volumes[t] = det / 6.0;
+
+        for (size_t d = 0; d < 3; ++d) {
+          double g1 = c23[d] * inv;
+          double g2 = c31[d] * inv;
+          double g3 = c12[d] * inv;
+          _b[d][t] = -(g1 + g2 + g3);
+          _b[3 + d][t] = g1;
+          _b[6 + d][t] = g2;
+          _b[9 + d][t] = g3;
+        }
+
+      }
+    });
+
+  }
+
+  /**
+   * Retrieve the number of tetrahedra.
+   */
+  [[nodiscard]] size_t
+  size() const { return _volumes.size(); }
+
+  /**
+   * Retrieve the signed volume of each tetrahedron (positive if its vertices
+   * are right handed).
+   */
+  [[nodiscard]] std::span<const double>
+  volumes() const { return _volumes; }
+
+  /**
+   * Retrieve a component of the shape function gradient of one of the local
+   * vertices, for each tetrahedron.
+   * @param k the local vertex (0 to 3).
+   * @param d the component (0 to 2).
+   */
+  [[nodiscard]] std::span<const double>
+  b(size_t k, size_t d) const { return _b[3 * k + d]; }
+
+  /**
+   * Compute the gradient of a field in each tetrahedron.
+   * @param mesh the mesh the cache was computed for.
+   * @param field the field.
+   * @return for each tetrahedron, the 3x3 matrix d m_i / d x_j (row major).
+   */
+  [[nodiscard]] std::vector<std::array<double, 9>>
+  gradient(const Mesh &mesh, const Field &field) const {
+
+    check(mesh, field);
+
+    const auto &til = mesh.til();
+    const auto &m = field.vectors();
+
+    std::vector<std::array<double, 9>> result(size());
+    parallel_for(size(), [&](size_t begin, size_t end) {
+      for (size_t t = begin; t < end; ++t) {
+        std::array<double, 9> g{};
+        for (size_t k = 0; k < 4; ++k) {
+          const fv &mk = m[til[t][k]];
+          for (size_t i = 0; i < 3; ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+              g[3 * i + j] += mk[i] * _b[3 * k + j][t];
+            }
+          }
+        }
+        result[t] = g;
+      }
+    });
+
+    return result;
+
+  }
+
+  /**
+   * Compute the curl of a field in each tetrahedron.
+   * @param mesh the mesh the cache was computed for.
+   * @param field the field.
+   * @return the curl in each tetrahedron.
+   */
+  [[nodiscard]] fv_list
+  curl(const Mesh &mesh, const Field &field) const {
+
+    check(mesh, field);
+
+    const auto &til = mesh.til();
+    const auto &m = field.vectors();
+
+    fv_list result(size());
+    parallel_for(size(), [&](size_t begin, size_t end) {
+      for (size_t t = begin; t < end; ++t) {
+        fv c{0.0, 0.0, 0.0};
+        for (size_t k = 0; k < 4; ++k) {
+          vert grad{_b[3 * k][t], _b[3 * k + 1][t], _b[3 * k + 2][t]};
+          c = add(c, cross(grad, m[til[t][k]]));
+        }
+        result[t] = c;
+      }
+    });
+
+    return result;
+
+  }
+
+  /**
+   * Compute the exchange energy of a field, A * sum over the tetrahedra of
+   * |grad m|^2 times the volume.
+   * @param mesh the mesh the cache was computed for.
+   * @param field the field.
+   * @param exchange_constant the exchange constant A.
+   * @return the exchange energy.
+   */
+  [[nodiscard]] double
+  exchange_energy(const Mesh &mesh, const Field &field, double exchange_constant) const {
+
+    check(mesh, field);
+
+    const auto &til = mesh.til();
+    const auto &m = field.vectors();
+
+    double energy = 0.0;
+    std::mutex energy_mutex;
+
+    parallel_for(size(), [&](size_t begin, size_t end) {
+      double sum = 0.0;
+      for (size_t t = begin; t < end; ++t) {
+        double g2 = 0.0;
+        for (size_t j = 0; j < 3; ++j) {
+          for (size_t i = 0; i < 3; ++i) {
+            double g = m[til[t][0]][i] * _b[j][t]
+                     + m[til[t][1]][i] * _b[3 + j][t]
+                     + m[til[t][2]][i] * _b[6 + j][t]
+                     + m[til[t][3]][i] * _b[9 + j][t];
+            g2 += g * g;
+          }
+        }
+        sum += g2 * std::abs(_volumes[t]);
+      }
+      std::lock_guard<std::mutex> lock(energy_mutex);
+      energy += sum;
+    });
+
+    return exchange_constant * energy;
+
+  }
+
+  /**
+   * Append a cache to an existing micromagnetic model file, under
+   * `/geometry': `volumes' [n] and `gradients' [12, n] (row 3k + d is
+   * component d of the gradient of local vertex k).
+   * @param file_name the name of the file.
+   * @param cache the cache.
+   */
+  static void
+  write(const std::string &file_name, const GeometryCache &cache) {
+
+    H5::H5File file(file_name, H5F_ACC_RDWR);
+
+    if (H5Lexists(file.getId(), GROUP, H5P_DEFAULT) > 0) {
+      file.unlink(GROUP);
+    }
+
+    H5::Group grp_geometry(file.createGroup(GROUP));
+
+    hsize_t dim_volumes[1] = {cache.size()};
+    H5::DataSpace dsp_volumes(1, dim_volumes);
+    H5::DataSet ds_volumes(
+        file.createDataSet(
+            std::string(GROUP) + "/volumes",
+            H5::PredType::NATIVE_DOUBLE,
+            dsp_volumes
+        )
+    );
+    ds_volumes.write(cache._volumes.data(), H5::PredType::NATIVE_DOUBLE);
+
+    hsize_t dim_gradients[2] = {12, cache.size()};
+    H5::DataSpace dsp_gradients(2, dim_gradients);
+    H5::DataSet ds_gradients(
+        file.createDataSet(
+            std::string(GROUP) + "/gradients",
+            H5::PredType::NATIVE_DOUBLE,
+            dsp_gradients
+        )
+    );
+
+    // One row at a time, straight from each array.
+    for (hsize_t row = 0; row < 12; ++row) {
+      hsize_t start[2] = {row, 0};
+      hsize_t count[2] = {1, cache.size()};
+      H5::DataSpace file_space = ds_gradients.getSpace();
+      file_space.selectHyperslab(H5S_SELECT_SET, count, start);
+      H5::DataSpace memory_space(1, &count[1]);
+      ds_gradients.write(cache._b[row].data(), H5::PredType::NATIVE_DOUBLE, memory_space, file_space);
+    }
+
+  }
+
+  /**
+   * Retrieve true if a micromagnetic model file holds a geometry cache.
+   * @param file_name the name of the file.
+   */
+  static bool
+  exists(const std::string &file_name) {
+
+    H5::H5File file(file_name, H5F_ACC_RDONLY);
+
+    return !group(file).empty();
+
+  }
+
+  /**
+   * Read a cache from a micromagnetic model file.
+   * @param file_name the name of the file.
+   * @param mesh the mesh of the file, used to check the cache's size.
+   * @return the cache.
+   */
+  static GeometryCache
+  read(const std::string &file_name, const Mesh &mesh) {
+
+    H5::H5File file(file_name, H5F_ACC_RDONLY);
+
+    std::string path = group(file);
+    if (path.empty()) {
+      throw GeometryCacheException("Path '/geometry' missing.");
+    }
+
+    GeometryCache cache;
+
+    H5::DataSet ds_volumes = file.openDataSet(path + "/volumes");
+    hsize_t n;
+    ds_volumes.getSpace().getSimpleExtentDims(&n, nullptr);
+
+    if (n != mesh.til().size()) {
+      throw GeometryCacheException("Geometry cache does not match the mesh.");
+    }
+
+    cache._volumes.resize(n);
+    ds_volumes.read(cache._volumes.data(), H5::PredType::NATIVE_DOUBLE);
+
+    H5::DataSet ds_gradients = file.openDataSet(path + "/gradients");
+    for (hsize_t row = 0; row < 12; ++row) {
+      cache._b[row].resize(n);
+      hsize_t start[2] = {row, 0};
+      hsize_t count[2] = {1, n};
+      H5::DataSpace file_space = ds_gradients.getSpace();
+      file_space.selectHyperslab(H5S_SELECT_SET, count, start);
+      H5::DataSpace memory_space(1, &n);
+      ds_gradients.read(cache._b[row].data(), H5::PredType::NATIVE_DOUBLE, memory_space, file_space);
+    }
+
+    return cache;
+
+  }
+
+ private:
+
+  std::vector<double> _volumes;
+
+  // _b[3 * k + d][t]: component d of the gradient of local vertex k of t.
+  std::array<std::vector<double>, 12> _b;
+
+  /**
+   * Create an empty cache (to be read in to).
+   */
+  GeometryCache() = default;
+
+  /**
+   * Retrieve the path of the cache in a file: `/geometry', or the legacy
+   * `/mesh/geometry', or empty if there is none.
+   * @param file the HDF5 file handle.
+   */
+  static std::string
+  group(H5::H5File &file) {
+
+    if (H5Lexists(file.getId(), GROUP, H5P_DEFAULT) > 0) return GROUP;
+
+    if (H5Lexists(file.getId(), "/mesh", H5P_DEFAULT) > 0
+        && H5Lexists(file.getId(), LEGACY_GROUP, H5P_DEFAULT) > 0) return LEGACY_GROUP;
+
+    return "";
+
+  }
+
+  /**
+   * Check that a mesh and field match the cache.
+   */
+  void
+  check(const Mesh &mesh, const Field &field) const {
+
+    if (mesh.til().size() != size() || field.vectors().size() != mesh.vcl().size()) {
+      throw GeometryCacheException("Field or mesh does not match the geometry cache.");
+    }
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_GEOMETRY_CACHE_HPP_
@@ -0,0 +1,136 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_HDF5_BLOCKS_HPP_
+#define MFC_INCLUDE_HDF5_BLOCKS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include <H5Cpp.h>
+
+#include "mapped_array.hpp"
+
+/**
+ * Retrieve the native HDF5 type of a scalar.
+ * @return the HDF5 type.
+ */
+template<typename T>
+const H5::PredType &
+native_type() {
+
+  if constexpr (std::is_same_v<T, float>) return H5::PredType::NATIVE_FLOAT;
+  else if constexpr (std::is_same_v<T, double>) return H5::PredType::NATIVE_DOUBLE;
+  else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4) return H5::PredType::NATIVE_INT32;
+  else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 8) return H5::PredType::NATIVE_INT64;
+  else if constexpr (std::is_integral_v<T> && sizeof(T) == 4) return H5::PredType::NATIVE_UINT32;
+  else if constexpr (std::is_integral_v<T> && sizeof(T) == 8) return H5::PredType::NATIVE_UINT64;
+  else static_assert(sizeof(T) == 0, "No native HDF5 type for this scalar.");
+
+}
+
+/**
+ * The shape of a row of an array element: its number of columns and the
+ * native HDF5 type of a column. 3-vectors are rows of 3 doubles, tetrahedra
+ * rows of 4 indices and indices single values.
+ */
+template<typename T>
+struct RowShape {
+
+  static constexpr hsize_t columns = 1;
+
+  static const H5::PredType &
+  type() { return native_type<T>(); }
+
+};
+
+template<typename E, size_t N>
+struct RowShape<std::array<E, N>> {
+
+  static constexpr hsize_t columns = N;
+
+  static const H5::PredType &
+  type() { return RowShape<E>::type(); }
+
+};
+
+/**
+ * Fill a mapped array from the rows of a data set, a block of rows at a
+ * time; each block's pages are released once written, so the resident set
+ * stays at about one block whatever the size of the data set.
+ * @param data_set the data set, [n], [n, columns] or [n_steps, n, columns].
+ * @param array the array, of n values.
+ * @param rows_per_block the number of rows per block.
+ * @param step the step to read, of an [n_steps, n, columns] data set.
+ */
+template<typename T>
+void
+read_blocks(const H5::DataSet &data_set, MappedArray<T> &array, hsize_t rows_per_block, hsize_t step = 0) {
+
+  using Shape = RowShape<T>;
+
+  array.advise(MappedAccess::SEQUENTIAL);
+
+  H5::DataSpace file_space = data_set.getSpace();
+  int rank = file_space.getSimpleExtentNdims();
+
+  // The step index only applies to a series; [n] and [n, columns] data sets
+  // are selected from their first row index on.
+  int lead = rank == 3 ? 0 : 1;
+
+  for (hsize_t first = 0; first < array.size(); first += rows_per_block) {
+
+    hsize_t count = std::min<hsize_t>(rows_per_block, array.size() - first);
+
+    hsize_t start[3] = {step, first, 0};
+    hsize_t dims[3] = {1, count, Shape::columns};
+    file_space.selectHyperslab(H5S_SELECT_SET, dims + lead, start + lead);
+    H5::DataSpace memory_space(std::min(rank, 2), dims + 1);
+
+    data_set.read(array.data() + first, Shape::type(), memory_space, file_space);
+    array.release(first, count);
+
+  }
+
+}
+
+/**
+ * Write a mapped array to the rows of a data set, a block of rows at a time,
+ * releasing each block's pages once it has been written.
+ * @param array the array, of n values.
+ * @param data_set the data set, [n] or [n, columns].
+ * @param rows_per_block the number of rows per block.
+ */
+template<typename T>
+void
+write_blocks(const MappedArray<T> &array, H5::DataSet &data_set, hsize_t rows_per_block) {
+
+  using Shape = RowShape<T>;
+
+  array.advise(MappedAccess::SEQUENTIAL);
+
+  H5::DataSpace file_space = data_set.getSpace();
+  int rank = file_space.getSimpleExtentNdims();
+
+  for (hsize_t first = 0; first < array.size(); first += rows_per_block) {
+
+    hsize_t count = std::min<hsize_t>(rows_per_block, array.size() - first);
+
+    array.will_need(first + count, std::min<hsize_t>(rows_per_block, array.size() - first - count));
+
+    hsize_t start[2] = {first, 0};
+    hsize_t dims[2] = {count, Shape::columns};
+    file_space.selectHyperslab(H5S_SELECT_SET, dims, start);
+    H5::DataSpace memory_space(rank, dims);
+
+    data_set.write(array.data() + first, Shape::type(), memory_space, file_space);
+    array.release(first, count);
+
+  }
+
+}
+
+#endif //MFC_INCLUDE_HDF5_BLOCKS_HPP_
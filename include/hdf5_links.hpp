@@ -0,0 +1,32 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_HDF5_LINKS_HPP_
+#define MFC_INCLUDE_HDF5_LINKS_HPP_
+
+#include <filesystem>
+#include <string>
+
+#include <H5Cpp.h>
+
+/**
+ * Retrieve the name to store in an HDF5 file for a file that it refers to
+ * (by external link or virtual data set mapping): the path relative to the
+ * file's own directory, which HDF5 searches first, so that the files can be
+ * moved together. Falls back to the absolute path.
+ * @param file the referring file.
+ * @param target the path of the referenced file.
+ * @return the name to store.
+ */
+inline std::string
+link_target(const H5::H5File &file, const std::filesystem::path &target) {
+
+  std::filesystem::path directory = std::filesystem::absolute(file.getFileName()).parent_path();
+  std::filesystem::path relative = std::filesystem::absolute(target).lexically_relative(directory);
+
+  return relative.empty() ? std::filesystem::absolute(target).string() : relative.string();
+
+}
+
+#endif //MFC_INCLUDE_HDF5_LINKS_HPP_
@@ -0,0 +1,176 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_HDF5_OPTIONS_HPP_
+#define MFC_INCLUDE_HDF5_OPTIONS_HPP_
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+#include <H5Cpp.h>
+
+class HDF5FileOptionsException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  HDF5FileOptionsException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * File format and metadata layout options for HDF5 files with many objects
+ * (e.g. thousands of `/fields/field<i>' groups). By default HDF5 writes the
+ * earliest compatible format: groups are symbol tables, and metadata is
+ * allocated in small blocks scattered between the raw data, so that opening
+ * a file and finding an object costs many small reads (slow on parallel file
+ * systems such as Lustre). The latest format indexes large groups (a B-tree
+ * over a fractal heap of links), and paged aggregation packs metadata in to
+ * whole pages that a page buffer reads in one go.
+ */
+struct HDF5FileOptions {
+
+  // Use the latest file format (needed for indexed groups).
+  bool latest_format = false;
+
+  // If not zero, aggregate file space in pages of this many bytes.
+  hsize_t page_size = 0;
+
+  // If not zero, the size in bytes of the page buffer used to read (and
+  // write) a paged file; must be at least one page.
+  size_t page_buffer_size = 0;
+
+  // Groups with more links than this switch from compact (in the group's
+  // object header) to indexed storage; latest format only.
+  unsigned max_compact = 8;
+
+  // Indexed groups with fewer links than this switch back to compact.
+  unsigned min_dense = 6;
+
+  // If not zero, the initial size in bytes of the metadata cache.
+  size_t metadata_cache_size = 0;
+
+  /**
+   * Retrieve options that favour opening files with many objects quickly:
+   * the latest format, 64 KiB pages with a 4 MiB page buffer and a 16 MiB
+   * metadata cache.
+   */
+  static HDF5FileOptions
+  tuned() {
+
+    HDF5FileOptions options;
+    options.latest_format = true;
+    options.page_size = 64 * 1024;
+    options.page_buffer_size = 4 * 1024 * 1024;
+    options.metadata_cache_size = 16 * 1024 * 1024;
+
+    return options;
+
+  }
+
+  /**
+   * Retrieve the file creation properties.
+   */
+  [[nodiscard]] H5::FileCreatPropList
+  create_properties() const {
+
+    H5::FileCreatPropList fcpl;
+
+    if (page_size > 0) {
+      check(H5Pset_file_space_strategy(fcpl.getId(), H5F_FSPACE_STRATEGY_PAGE, false, 1),
+            "Could not select paged aggregation.");
+      check(H5Pset_file_space_page_size(fcpl.getId(), page_size),
+            "Could not set the page size to " + std::to_string(page_size) + ".");
+    }
+
+    return fcpl;
+
+  }
+
+  /**
+   * Retrieve the file access properties (for both writing and reading).
+   */
+  [[nodiscard]] H5::FileAccPropList
+  access_properties() const {
+
+    H5::FileAccPropList fapl;
+
+    if (latest_format) {
+      fapl.setLibverBounds(H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+    }
+
+    if (page_buffer_size > 0) {
+      check(H5Pset_page_buffer_size(fapl.getId(), page_buffer_size, 0, 0),
+            "Could not set the page buffer size to " + std::to_string(page_buffer_size) + ".");
+    }
+
+    if (metadata_cache_size > 0) {
+      H5AC_cache_config_t config;
+      config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+      check(H5Pget_mdc_config(fapl.getId(), &config), "Could not get the metadata cache configuration.");
+
+      config.set_initial_size = true;
+      config.initial_size = metadata_cache_size;
+      config.max_size = std::max(config.max_size, metadata_cache_size);
+      config.min_size = std::min(config.min_size, metadata_cache_size);
+      check(H5Pset_mdc_config(fapl.getId(), &config), "Could not set the metadata cache configuration.");
+    }
+
+    return fapl;
+
+  }
+
+  /**
+   * Create a group that may hold many links, with the compact/indexed
+   * thresholds of these options.
+   * @param file the HDF5 file handle.
+   * @param name the name of the group.
+   * @return the group.
+   */
+  H5::Group
+  create_group(H5::H5File &file, const std::string &name) const {
+
+    hid_t gcpl = H5Pcreate(H5P_GROUP_CREATE);
+    if (latest_format) H5Pset_link_phase_change(gcpl, max_compact, min_dense);
+
+    hid_t id = H5Gcreate2(file.getId(), name.c_str(), H5P_DEFAULT, gcpl, H5P_DEFAULT);
+    H5Pclose(gcpl);
+    check(id < 0 ? -1 : 0, "Could not create group '" + name + "'.");
+
+    H5::Group group(id);
+    H5Gclose(id);
+
+    return group;
+
+  }
+
+ private:
+
+  static void
+  check(herr_t status, const std::string &message) {
+
+    if (status < 0) throw HDF5FileOptionsException(message);
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_HDF5_OPTIONS_HPP_
@@ -0,0 +1,102 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_HDF5_VECTORS_HPP_
+#define MFC_INCLUDE_HDF5_VECTORS_HPP_
+
+#include <string>
+
+#include <H5Cpp.h>
+
+#include "vector_array.hpp"
+
+/**
+ * Write the vectors of a view (any layout) to rows of an [n, 3] double data
+ * set. AoS views are written in one go; otherwise each component is written
+ * with a strided memory selection (every block's run of that component) in
+ * to one column of the file, so no transposed copy is made.
+ * @param data_set the data set.
+ * @param view the vectors.
+ * @param first_row the first row of the data set to write to.
+ */
+inline void
+write_vectors(H5::DataSet &data_set, const VectorView &view, hsize_t first_row = 0) {
+
+  if (view.size() == 0) return;
+
+  hsize_t n = view.size();
+  hsize_t block = view.block();
+
+  H5::DataSpace file_space = data_set.getSpace();
+
+  if (block == 1) {
+
+    hsize_t start[2] = {first_row, 0};
+    hsize_t count[2] = {n, 3};
+    file_space.selectHyperslab(H5S_SELECT_SET, count, start);
+
+    H5::DataSpace memory_space(2, count);
+    data_set.write(view.data(), H5::PredType::NATIVE_DOUBLE, memory_space, file_space);
+
+    return;
+
+  }
+
+  hsize_t n_full = n / block;
+  hsize_t rest = n % block;
+  hsize_t extent = view.extent();
+
+  for (hsize_t c = 0; c < 3; ++c) {
+
+    // Memory: component c of every full block, then of the partial block.
+    H5::DataSpace memory_space(1, &extent);
+    if (n_full > 0) {
+      hsize_t start = c * block;
+      hsize_t stride = 3 * block;
+      memory_space.selectHyperslab(H5S_SELECT_SET, &n_full, &start, &stride, &block);
+    }
+    if (rest > 0) {
+      hsize_t start = n_full * 3 * block + c * block;
+      memory_space.selectHyperslab(
+          n_full > 0 ? H5S_SELECT_OR : H5S_SELECT_SET, &rest, &start
+      );
+    }
+
+    // File: column c.
+    hsize_t start[2] = {first_row, c};
+    hsize_t count[2] = {n, 1};
+    file_space.selectHyperslab(H5S_SELECT_SET, count, start);
+
+    data_set.write(view.data(), H5::PredType::NATIVE_DOUBLE, memory_space, file_space);
+
+  }
+
+}
+
+/**
+ * Create an [n, 3] data set and write the vectors of a view to it.
+ * @param file the HDF5 file handle.
+ * @param data_set_name the name of the data set.
+ * @param view the vectors.
+ * @param file_type the type stored in the file (HDF5 converts the doubles
+ *                  to it while writing).
+ */
+inline void
+write_vectors(H5::H5File &file,
+              const std::string &data_set_name,
+              const VectorView &view,
+              const H5::PredType &file_type = H5::PredType::NATIVE_DOUBLE) {
+
+  hsize_t dims[2] = {view.size(), 3};
+  H5::DataSpace data_space(2, dims);
+
+  H5::DataSet data_set(
+      file.createDataSet(data_set_name, file_type, data_space)
+  );
+
+  write_vectors(data_set, view);
+
+}
+
+#endif //MFC_INCLUDE_HDF5_VECTORS_HPP_
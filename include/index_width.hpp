@@ -0,0 +1,97 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_INDEX_WIDTH_HPP_
+#define MFC_INCLUDE_INDEX_WIDTH_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+#include <H5Cpp.h>
+
+#include "mesh.hpp"
+#include "parallel.hpp"
+
+/**
+ * Retrieve the size in bytes (2, 4 or 8) of the narrowest unsigned integer
+ * type that can hold a value.
+ * @param max_value the largest value to hold.
+ * @return the number of bytes.
+ */
+inline size_t
+index_bytes(uint64_t max_value) {
+
+  if (max_value <= std::numeric_limits<uint16_t>::max()) return 2;
+  if (max_value <= std::numeric_limits<uint32_t>::max()) return 4;
+
+  return 8;
+
+}
+
+/**
+ * Retrieve the native HDF5 unsigned integer type of a given size.
+ * @param bytes the number of bytes (2, 4 or 8).
+ * @return the HDF5 type.
+ */
+inline const H5::PredType &
+index_type(size_t bytes) {
+
+  if (bytes == 2) return H5::PredType::NATIVE_UINT16;
+  if (bytes == 4) return H5::PredType::NATIVE_UINT32;
+
+  return H5::PredType::NATIVE_UINT64;
+
+}
+
+/**
+ * Retrieve the number of bytes needed to store a mesh's element vertex
+ * indices. The width is that of the largest index actually used, rather than
+ * the number of vertices, so that an out of range index (in a mesh that was
+ * not validated) is stored as it is instead of being narrowed.
+ * @param mesh the mesh.
+ * @return the number of bytes (2, 4 or 8).
+ */
+inline size_t
+element_index_bytes(const Mesh &mesh) {
+
+  const tet_list &til = mesh.til();
+
+  uint64_t max_index = 0;
+  std::mutex max_mutex;
+
+  parallel_for(til.size(), [&](size_t begin, size_t end) {
+
+    uint64_t block_max = 0;
+    for (size_t t = begin; t < end; ++t) {
+      const tet &v = til[t];
+      block_max = std::max<uint64_t>(block_max, std::max(std::max(v[0], v[1]), std::max(v[2], v[3])));
+    }
+
+    std::lock_guard<std::mutex> lock(max_mutex);
+    max_index = std::max(max_index, block_max);
+
+  });
+
+  return index_bytes(max_index);
+
+}
+
+/**
+ * Retrieve the number of bytes needed to store a mesh's submesh ids.
+ * @param mesh the mesh.
+ * @return the number of bytes (2, 4 or 8).
+ */
+inline size_t
+submesh_index_bytes(const Mesh &mesh) {
+
+  uint64_t max_id = 0;
+  for (auto id : mesh.sml()) max_id = std::max<uint64_t>(max_id, id);
+
+  return index_bytes(max_id);
+
+}
+
+#endif //MFC_INCLUDE_INDEX_WIDTH_HPP_
@@ -12,6 +12,7 @@
 #include <H5Cpp.h>
 
 #include "aliases.hpp"
+#include "mesh_registry.hpp"
 #include "model.hpp"
 
 /**
@@ -57,10 +58,12 @@ class ExodusIILoader {
   /**
    * Function that will read a file and produce a Model object.
    * @param file_name the name of the file.
+   * @param registry if given, the mesh is shared with earlier loads of the
+   *                 same mesh.
    * @return a new model object, this object will only contain Mesh information.
    */
   static Model
-  read(const std::string &file_name) {
+  read(const std::string &file_name, MeshRegistry *registry = nullptr) {
 
     H5::H5File file(file_name, H5F_ACC_RDONLY);
 
@@ -116,7 +119,10 @@ class ExodusIILoader {
 
     }
 
-    return {vcl, til, sml};
+    return {
+        MeshRegistry::share(Mesh(std::move(vcl), std::move(til), std::move(sml)), registry),
+        FieldList()
+    };
 
   }
 
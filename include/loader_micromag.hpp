@@ -5,14 +5,23 @@
 #ifndef MFC_INCLUDE_LOADER_MICROMAG_HPP_
 #define MFC_INCLUDE_LOADER_MICROMAG_HPP_
 
+#include <cstdint>
 #include <exception>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <sstream>
 
 #include <H5Cpp.h>
 
 #include "aliases.hpp"
+#include "hdf5_blocks.hpp"
+#include "hdf5_options.hpp"
+#include "mapped_model.hpp"
+#include "mesh_registry.hpp"
 #include "model.hpp"
+#include "model_buffers.hpp"
 
 /**
  * Object that will be thrown on micromagnetic model file '*.mmf" loading
@@ -58,29 +67,423 @@ class MicromagFileLoader {
   /**
    * Function that will read a file and produce a Model object.
    * @param file_name the name of the file.
-   * @return a new model object, this object will only contain Mesh information.
+   * @param registry if given, the mesh is shared with earlier loads of the
+   *                 same mesh; a mesh that is tagged with the hash of one
+   *                 that is already registered is not read at all.
+   * @param options the file access options (e.g. a page buffer for paged
+   *                files).
+   * @return a new model object, with the file's mesh and fields.
    */
   static Model
-  read(const std::string &file_name) {
+  read(const std::string &file_name,
+       MeshRegistry *registry = nullptr,
+       const HDF5FileOptions &options = {}) {
+
+    H5::H5File file(file_name, H5F_ACC_RDONLY, H5::FileCreatPropList::DEFAULT, options.access_properties());
+
+    std::shared_ptr<const Mesh> mesh = read_mesh(file, registry);
+    FieldList field_list = read_fields(file, mesh->vcl().size());
+
+    return {std::move(mesh), std::move(field_list)};
+
+  }
+
+  /**
+   * Function that will read the mesh of an open file.
+   * @param file the HDF5 file handle.
+   * @param registry if given, the mesh is shared with earlier loads of the
+   *                 same mesh (see `read').
+   * @return the mesh.
+   */
+  static std::shared_ptr<const Mesh>
+  read_mesh(H5::H5File &file, MeshRegistry *registry = nullptr) {
 
     v_list vcl;
     tet_list til;
     sm_list sml;
 
-    H5::H5File file(file_name, H5F_ACC_RDONLY);
-
+    check_mesh_link(file.getId());
     check_for_paths(file.getId());
 
+    if (registry) {
+      if (auto hash = stored_mesh_hash(file)) {
+        if (auto mesh = registry->find(*hash)) return mesh;
+      }
+    }
+
     read_data_set("/mesh/vertices", file, vcl);
     read_data_set("/mesh/elements", file, til);
     read_data_set("/mesh/submesh", file, sml);
 
-    return {vcl, til, sml};
+    // The original indices of a reordered mesh.
+    vi_list vertex_ids;
+    teti_list element_ids;
+
+    if (path_exists(file.getId(), "/mesh/vertex_ids")) {
+      read_data_set("/mesh/vertex_ids", file, vertex_ids);
+    }
+
+    if (path_exists(file.getId(), "/mesh/element_ids")) {
+      read_data_set("/mesh/element_ids", file, element_ids);
+    }
+
+    return MeshRegistry::share(
+        Mesh(std::move(vcl), std::move(til), std::move(sml), std::move(vertex_ids), std::move(element_ids)),
+        registry
+    );
+
+  }
+
+  /**
+   * Function that will read the fields of an open file in to one contiguous
+   * block: from the `/fields/field<i>' groups or, if there are none, from the
+   * steps of a `/fields/series' data set (as written by MicromagSeriesWriter).
+   * @param file the HDF5 file handle.
+   * @param n_vertices the number of vertices of the file's mesh.
+   * @return the fields.
+   */
+  static FieldList
+  read_fields(H5::H5File &file, size_t n_vertices) {
+
+    size_t n_fields = count_fields(file.getId());
+
+    if (n_fields > 0) {
+
+      std::vector<std::string> annotations;
+      for (size_t i = 0; i < n_fields; ++i) {
+        annotations.push_back(field_annotation(file, "/fields/field" + std::to_string(i)));
+      }
+
+      FieldList field_list(annotations, n_vertices);
+      for (size_t i = 0; i < n_fields; ++i) {
+        read_rows(file,
+                  "/fields/field" + std::to_string(i) + "/vectors",
+                  StridedSpan<double>(field_list.fields()[i].vectors().data()->data(), n_vertices, 3, 3),
+                  3);
+      }
+
+      return field_list;
+
+    }
+
+    if (!path_exists(file.getId(), "/fields/series")) return {};
+
+    H5::DataSet series = file.openDataSet("/fields/series");
+
+    hsize_t dims[3] = {0, 0, 0};
+    series.getSpace().getSimpleExtentDims(dims, nullptr);
+
+    if (dims[1] != n_vertices || dims[2] != 3) {
+      throw MicromagFileLoaderException(
+          "'/fields/series' has " + std::to_string(dims[1]) + " vectors per step, mesh has "
+              + std::to_string(n_vertices) + " vertices.");
+    }
+
+    if (dims[0] == 0) return {};
+
+    FieldList field_list(dims[0], n_vertices);
+    series.read(field_list.block().data(), H5::PredType::NATIVE_DOUBLE);
+
+    return field_list;
+
+  }
+
+  /**
+   * Function that will read a file in to file backed arrays, for models that
+   * do not fit in memory. The data is copied a block of rows at a time, so
+   * that only about one block is resident at once. The backing files
+   * `vertices.bin', `elements.bin', `submesh.bin', `vertex_ids.bin' and
+   * `element_ids.bin' (reordered meshes only) and `field<i>.bin' are created
+   * in (and left in) the given directory. The fields are read from the
+   * `/fields/field<i>' groups or, if there are none, from the steps of a
+   * `/fields/series' data set (as written by MicromagSeriesWriter).
+   * @param file_name the name of the file.
+   * @param directory the directory for the backing files.
+   * @param rows_per_block the number of rows copied per block.
+   * @return the out-of-core model.
+   */
+  static MappedModel
+  read_mapped(const std::string &file_name,
+              const std::string &directory,
+              hsize_t rows_per_block = hsize_t{1} << 20) {
+
+    H5::H5File file(file_name, H5F_ACC_RDONLY);
+
+    check_mesh_link(file.getId());
+    check_for_paths(file.getId());
+
+    MappedModel model;
+    model.vcl = read_mapped_data_set<vert>(file, "/mesh/vertices", directory + "/vertices.bin", rows_per_block);
+    model.til = read_mapped_data_set<tet>(file, "/mesh/elements", directory + "/elements.bin", rows_per_block);
+    model.sml = read_mapped_data_set<size_t>(file, "/mesh/submesh", directory + "/submesh.bin", rows_per_block);
+
+    // The original indices of a reordered mesh.
+    if (path_exists(file.getId(), "/mesh/vertex_ids")) {
+      model.vertex_ids = read_mapped_data_set<size_t>(
+          file, "/mesh/vertex_ids", directory + "/vertex_ids.bin", rows_per_block
+      );
+    }
+
+    if (path_exists(file.getId(), "/mesh/element_ids")) {
+      model.element_ids = read_mapped_data_set<size_t>(
+          file, "/mesh/element_ids", directory + "/element_ids.bin", rows_per_block
+      );
+    }
+
+    model.hash = stored_mesh_hash(file);
+
+    size_t n_fields = count_fields(file.getId());
+    for (size_t i = 0; i < n_fields; ++i) {
+      model.fields.push_back(
+          read_mapped_data_set<fv>(
+              file,
+              "/fields/field" + std::to_string(i) + "/vectors",
+              directory + "/field" + std::to_string(i) + ".bin",
+              rows_per_block
+          )
+      );
+    }
+
+    if (n_fields == 0 && path_exists(file.getId(), "/fields/series")) {
+
+      hsize_t dims[3] = {0, 0, 0};
+      file.openDataSet("/fields/series").getSpace().getSimpleExtentDims(dims, nullptr);
+
+      for (hsize_t i = 0; i < dims[0]; ++i) {
+        model.fields.push_back(
+            read_mapped_data_set<fv>(
+                file,
+                "/fields/series",
+                directory + "/field" + std::to_string(i) + ".bin",
+                rows_per_block,
+                i
+            )
+        );
+      }
+
+    }
+
+    return model;
+
+  }
+
+  /**
+   * Function that will read the sizes of the arrays in a file, so that a
+   * caller can allocate the buffers for `read_into'.
+   * @param file_name the name of the file.
+   * @param options the file access options.
+   * @return the shape of the stored model.
+   */
+  static ModelShape
+  shape(const std::string &file_name, const HDF5FileOptions &options = {}) {
+
+    H5::H5File file(file_name, H5F_ACC_RDONLY, H5::FileCreatPropList::DEFAULT, options.access_properties());
+
+    check_mesh_link(file.getId());
+    check_for_paths(file.getId());
+
+    ModelShape shape;
+    shape.n_vertices = rows(file, "/mesh/vertices");
+    shape.n_elements = rows(file, "/mesh/elements");
+    shape.n_fields = count_fields(file.getId());
+    shape.has_vertex_ids = path_exists(file.getId(), "/mesh/vertex_ids");
+    shape.has_element_ids = path_exists(file.getId(), "/mesh/element_ids");
+
+    return shape;
+
+  }
+
+  /**
+   * Function that will read a file directly in to caller owned buffers,
+   * converting to the buffers' value types, without allocating a Model.
+   * Empty views in `buffers' are skipped; the others must match the file's
+   * shape (see `shape').
+   * @param file_name the name of the file.
+   * @param buffers the buffers to fill.
+   */
+  template<typename Real, typename Index>
+  static void
+  read_into(const std::string &file_name, const ModelBuffers<Real, Index> &buffers) {
+
+    H5::H5File file(file_name, H5F_ACC_RDONLY);
+
+    check_mesh_link(file.getId());
+    check_for_paths(file.getId());
+
+    read_rows(file, "/mesh/vertices", buffers.vertices, 3);
+    read_rows(file, "/mesh/elements", buffers.elements, 4);
+    read_values(file, "/mesh/submesh", buffers.submesh);
+
+    if (!buffers.vertex_ids.empty()) read_values(file, "/mesh/vertex_ids", buffers.vertex_ids);
+    if (!buffers.element_ids.empty()) read_values(file, "/mesh/element_ids", buffers.element_ids);
+
+    size_t n_fields = count_fields(file.getId());
+    if (buffers.fields.size() > n_fields) {
+      throw MicromagFileLoaderException(
+          "Buffers for " + std::to_string(buffers.fields.size()) + " fields given, file has "
+              + std::to_string(n_fields) + ".");
+    }
+
+    for (size_t i = 0; i < buffers.fields.size(); ++i) {
+      read_rows(file, "/fields/field" + std::to_string(i) + "/vectors", buffers.fields[i], 3);
+    }
 
   }
 
  private:
 
+  /**
+   * Retrieve the number of rows of a data set.
+   * @param file the HDF5 file handle.
+   * @param data_set_name the name of the data set.
+   * @return the number of rows.
+   */
+  static size_t
+  rows(H5::H5File &file, const std::string &data_set_name) {
+
+    hsize_t dims[2] = {0, 0};
+    file.openDataSet(data_set_name).getSpace().getSimpleExtentDims(dims, nullptr);
+
+    return dims[0];
+
+  }
+
+  /**
+   * Retrieve the annotation of a field group, which is stored as the name of
+   * its (only) attribute.
+   * @param file the HDF5 file handle.
+   * @param group_name the name of the field's group.
+   * @return the annotation, or an empty string if there is none.
+   */
+  static std::string
+  field_annotation(H5::H5File &file, const std::string &group_name) {
+
+    H5::Group group = file.openGroup(group_name);
+    if (group.getNumAttrs() == 0) return {};
+
+    return group.openAttribute(static_cast<unsigned>(0)).getName();
+
+  }
+
+  /**
+   * Retrieve the number of consecutive `/fields/field<i>' groups in a file.
+   * @param id the HDF5 file id.
+   * @return the number of fields.
+   */
+  static size_t
+  count_fields(hid_t id) {
+
+    if (!path_exists(id, "/fields")) return 0;
+
+    size_t n = 0;
+    while (path_exists(id, "/fields/field" + std::to_string(n))) ++n;
+
+    return n;
+
+  }
+
+  /**
+   * Read an [n, columns] data set in to a (possibly padded) caller buffer;
+   * the stride is described to HDF5 as a hyperslab of the memory space, so
+   * the values land in place without a staging copy. Empty views are skipped.
+   * @param file the HDF5 file handle.
+   * @param data_set_name the name of the data set.
+   * @param view the buffer.
+   * @param columns the expected number of columns.
+   */
+  template<typename T>
+  static void
+  read_rows(H5::H5File &file, const std::string &data_set_name, const StridedSpan<T> &view, hsize_t columns) {
+
+    if (view.empty()) return;
+
+    H5::DataSet data_set = file.openDataSet(data_set_name);
+    H5::DataSpace file_space = data_set.getSpace();
+
+    hsize_t dims[2] = {0, 0};
+    file_space.getSimpleExtentDims(dims, nullptr);
+
+    if (view.rows() != dims[0] || view.columns() != columns || dims[1] != columns
+        || view.stride() < view.columns()) {
+      throw MicromagFileLoaderException(
+          "Buffer for '" + data_set_name + "' is " + std::to_string(view.rows()) + "x"
+              + std::to_string(view.columns()) + " (stride " + std::to_string(view.stride())
+              + "), data set is " + std::to_string(dims[0]) + "x" + std::to_string(dims[1]) + ".");
+    }
+
+    hsize_t memory_dims[2] = {view.rows(), view.stride()};
+    H5::DataSpace memory_space(2, memory_dims);
+
+    hsize_t start[2] = {0, 0};
+    hsize_t count[2] = {view.rows(), columns};
+    memory_space.selectHyperslab(H5S_SELECT_SET, count, start);
+
+    data_set.read(view.data(), native_type<T>(), memory_space, file_space);
+
+  }
+
+  /**
+   * Read an [n] data set in to a caller buffer.
+   * @param file the HDF5 file handle.
+   * @param data_set_name the name of the data set.
+   * @param values the buffer, of n values (skipped if empty).
+   */
+  template<typename T>
+  static void
+  read_values(H5::H5File &file, const std::string &data_set_name, std::span<T> values) {
+
+    if (values.empty()) return;
+
+    if (!path_exists(file.getId(), data_set_name)) {
+      throw MicromagFileLoaderException("Path '" + data_set_name + "' missing.");
+    }
+
+    H5::DataSet data_set = file.openDataSet(data_set_name);
+    H5::DataSpace file_space = data_set.getSpace();
+
+    hsize_t dims[1] = {0};
+    file_space.getSimpleExtentDims(dims, nullptr);
+
+    if (values.size() != dims[0]) {
+      throw MicromagFileLoaderException(
+          "Buffer for '" + data_set_name + "' holds " + std::to_string(values.size())
+              + " values, data set has " + std::to_string(dims[0]) + ".");
+    }
+
+    H5::DataSpace memory_space(1, dims);
+    data_set.read(values.data(), native_type<T>(), memory_space, file_space);
+
+  }
+
+  /**
+   * Copy a data set (or one step of a series) in to a new file backed array.
+   * @param file the HDF5 file handle.
+   * @param data_set_name the name of the data set.
+   * @param path the path of the backing file.
+   * @param rows_per_block the number of rows copied per block.
+   * @param step the step to copy, of an [n_steps, n, columns] data set.
+   * @return the array.
+   */
+  template<typename T>
+  static MappedArray<T>
+  read_mapped_data_set(H5::H5File &file,
+                       const std::string &data_set_name,
+                       const std::string &path,
+                       hsize_t rows_per_block,
+                       hsize_t step = 0) {
+
+    H5::DataSet data_set = file.openDataSet(data_set_name);
+
+    hsize_t dims[3] = {0, 0, 0};
+    int rank = data_set.getSpace().getSimpleExtentDims(dims, nullptr);
+
+    auto array = MappedArray<T>::create(path, rank == 3 ? dims[1] : dims[0]);
+    read_blocks(data_set, array, rows_per_block, step);
+
+    return array;
+
+  }
+
   /**
    * Function to read a data set with a given name in to a 'double' array.
    * @param data_set_name the name of the data set.
@@ -182,6 +585,56 @@ class MicromagFileLoader {
 
   }
 
+  /**
+   * Retrieve the content hash that a mesh was tagged with when written, if
+   * its vertices were stored at double precision (a single precision copy
+   * does not match the mesh that was hashed).
+   * @param file the HDF5 file handle.
+   * @return the hash, if any.
+   */
+  static std::optional<uint64_t>
+  stored_mesh_hash(H5::H5File &file) {
+
+    H5::Group grp_mesh = file.openGroup("/mesh");
+    if (!grp_mesh.attrExists("hash")) return std::nullopt;
+
+    if (file.openDataSet("/mesh/vertices").getDataType().getSize() != sizeof(double)) return std::nullopt;
+
+    uint64_t hash = 0;
+    grp_mesh.openAttribute("hash").read(H5::PredType::NATIVE_UINT64, &hash);
+
+    return hash;
+
+  }
+
+  /**
+   * Check that, if `/mesh' is an external link in to a mesh store, the store
+   * file can be found (HDF5 looks for it relative to the file's directory,
+   * then the working directory).
+   * @param id the HDF5 file id.
+   */
+  static void
+  check_mesh_link(hid_t id) {
+
+    H5L_info_t info;
+    if (H5Lexists(id, "/mesh", H5P_DEFAULT) <= 0) return;
+    if (H5Lget_info(id, "/mesh", &info, H5P_DEFAULT) < 0 || info.type != H5L_TYPE_EXTERNAL) return;
+
+    H5E_BEGIN_TRY {
+      if (H5Oexists_by_name(id, "/mesh", H5P_DEFAULT) > 0) return;
+    } H5E_END_TRY;
+
+    std::string value(info.u.val_size, '\0');
+    const char *target_file = nullptr;
+    const char *target_path = nullptr;
+    H5Lget_val(id, "/mesh", value.data(), value.size(), H5P_DEFAULT);
+    H5Lunpack_elink_val(value.data(), value.size(), nullptr, &target_file, &target_path);
+
+    throw MicromagFileLoaderException(
+        "Mesh store file '" + std::string(target_file ? target_file : "") + "' for '/mesh' not found.");
+
+  }
+
   /**
    * Check that the data set paths
    * - `/mesh/vertices'
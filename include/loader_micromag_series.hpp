@@ -0,0 +1,181 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_LOADER_MICROMAG_SERIES_HPP_
+#define MFC_INCLUDE_LOADER_MICROMAG_SERIES_HPP_
+
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <H5Cpp.h>
+
+#include "aliases.hpp"
+#include "field.hpp"
+#include "loader_micromag.hpp"
+#include "mesh_registry.hpp"
+
+/**
+ * Object that will be thrown on live micromagnetic model file reading
+ * exception.
+ */
+class MicromagSeriesReaderException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  MicromagSeriesReaderException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * Object that will read a micromagnetic model file while it is being written
+ * by a MicromagSeriesWriter (HDF5 single-writer/multiple-reader mode). The
+ * file is opened once; `refresh' (or `poll') picks up the fields that have
+ * been appended since, which `read' then reads.
+ */
+class MicromagSeriesReader {
+
+ public:
+
+  /**
+   * Open a file that is being written and read its mesh.
+   * @param file_name the name of the file.
+   * @param registry if given, the mesh is shared with earlier loads of the
+   *                 same mesh.
+   */
+  explicit MicromagSeriesReader(const std::string &file_name, MeshRegistry *registry = nullptr) :
+      _file(file_name, H5F_ACC_RDONLY | H5F_ACC_SWMR_READ) {
+
+    _mesh = MicromagFileLoader::read_mesh(_file, registry);
+
+    if (H5Lexists(_file.getId(), "/fields", H5P_DEFAULT) <= 0
+        || H5Lexists(_file.getId(), "/fields/series", H5P_DEFAULT) <= 0) {
+      throw MicromagSeriesReaderException("Path '/fields/series' missing.");
+    }
+
+    _series = _file.openDataSet("/fields/series");
+
+    refresh();
+
+  }
+
+  /**
+   * Retrieve the mesh.
+   */
+  [[nodiscard]] const std::shared_ptr<const Mesh> &
+  mesh() const { return _mesh; }
+
+  /**
+   * Retrieve the number of fields that were available at the last refresh.
+   */
+  [[nodiscard]] size_t
+  n_steps() const { return _n_steps; }
+
+  /**
+   * Pick up the fields that have been appended since the last refresh.
+   * @return the number of new fields.
+   */
+  size_t
+  refresh() {
+
+    if (H5Drefresh(_series.getId()) < 0) {
+      throw MicromagSeriesReaderException("Could not refresh '/fields/series'.");
+    }
+
+    hsize_t dims[3] = {0, 0, 0};
+    _series.getSpace().getSimpleExtentDims(dims, nullptr);
+
+    size_t n_new = dims[0] - _n_steps;
+    _n_steps = dims[0];
+
+    return n_new;
+
+  }
+
+  /**
+   * Refresh every `interval' until new fields have been appended, or the
+   * timeout has passed.
+   * @param timeout the longest time to wait.
+   * @param interval the time between refreshes.
+   * @return the number of new fields (zero on timeout).
+   */
+  size_t
+  poll(std::chrono::milliseconds timeout,
+       std::chrono::milliseconds interval = std::chrono::milliseconds(100)) {
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    for (;;) {
+      if (size_t n_new = refresh(); n_new > 0) return n_new;
+      if (std::chrono::steady_clock::now() + interval > deadline) return 0;
+      std::this_thread::sleep_for(interval);
+    }
+
+  }
+
+  /**
+   * Read a run of fields (that were available at the last refresh) with one
+   * read, in to one contiguous block.
+   * @param first the first field.
+   * @param count the number of fields.
+   * @return the fields.
+   */
+  FieldList
+  read(size_t first, size_t count) {
+
+    if (first + count > _n_steps) {
+      throw MicromagSeriesReaderException(
+          "Fields " + std::to_string(first) + " to " + std::to_string(first + count) + " requested, "
+              + std::to_string(_n_steps) + " available.");
+    }
+
+    size_t n_vertices = _mesh->vcl().size();
+
+    FieldList field_list(count, n_vertices);
+    if (count == 0) return field_list;
+
+    H5::DataSpace file_space = _series.getSpace();
+    hsize_t start[3] = {first, 0, 0};
+    hsize_t dims[3] = {count, n_vertices, 3};
+    file_space.selectHyperslab(H5S_SELECT_SET, dims, start);
+    H5::DataSpace memory_space(3, dims);
+
+    _series.read(field_list.block().data(), H5::PredType::NATIVE_DOUBLE, memory_space, file_space);
+
+    return field_list;
+
+  }
+
+ private:
+
+  H5::H5File _file;
+
+  H5::DataSet _series;
+
+  std::shared_ptr<const Mesh> _mesh;
+
+  size_t _n_steps = 0;
+
+};
+
+#endif //MFC_INCLUDE_LOADER_MICROMAG_SERIES_HPP_
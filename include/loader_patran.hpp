@@ -0,0 +1,474 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_LOADER_PATRAN_HPP_
+#define MFC_INCLUDE_LOADER_PATRAN_HPP_
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <sstream>
+#include <vector>
+
+#include "aliases.hpp"
+#include "mesh_registry.hpp"
+#include "model.hpp"
+#include "parallel.hpp"
+
+/**
+ * Object that will be thrown on Patran neutral file `*.pat' loading
+ * exception.
+ */
+class PatranLoaderException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  PatranLoaderException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * Object that will load Patran neutral files (the native MERRILL mesh input).
+ *
+ * Only the packets required to reconstruct a tetrahedral mesh are decoded:
+ * - packet 01: node coordinates,
+ * - packet 02: elements (tetrahedra only), the property id (or the material
+ *              configuration id if the property id is zero) becomes the
+ *              element's submesh index,
+ * - packet 26: summary data, used to size the output lists up front.
+ * All other packets are skipped using their card count.
+ *
+ * The file is read in to memory in one go and a cheap serial pass records
+ * where each node and element packet starts. The packets are then decoded in
+ * parallel over contiguous ranges, straight from the fixed columns of the
+ * file buffer without creating any intermediate strings.
+ */
+class PatranLoader {
+
+ public:
+
+  /**
+   * Default constructor.
+   */
+  PatranLoader() = default;
+
+  /**
+   * Function that will read a file and produce a Model object.
+   * @param file_name the name of the file.
+   * @param registry if given, the mesh is shared with earlier loads of the
+   *                 same mesh.
+   * @return a new model object, this object will only contain Mesh information.
+   */
+  static Model
+  read(const std::string &file_name, MeshRegistry *registry = nullptr) {
+
+    std::string buffer = read_buffer(file_name);
+
+    // Record the offsets of the node and element packet headers.
+    std::vector<size_t> node_offsets;
+    std::vector<size_t> elem_offsets;
+    index_packets(buffer, node_offsets, elem_offsets);
+
+    if (node_offsets.empty()) {
+      throw PatranLoaderException("No nodes (packet 01) found.");
+    }
+
+    if (elem_offsets.empty()) {
+      throw PatranLoaderException("No elements (packet 02) found.");
+    }
+
+    // Decode the nodes.
+    v_list vcl(node_offsets.size());
+    std::vector<size_t> node_ids(node_offsets.size());
+
+    parallel_for(node_offsets.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        decode_node(buffer, node_offsets[i], node_ids[i], vcl[i]);
+      }
+    });
+
+    // Decode the elements.
+    tet_list til(elem_offsets.size());
+    sm_list sml(elem_offsets.size());
+
+    parallel_for(elem_offsets.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        decode_element(buffer, elem_offsets[i], til[i], sml[i]);
+      }
+    });
+
+    // Convert node ids to vertex indices.
+    renumber(node_ids, til);
+
+    return {
+        MeshRegistry::share(Mesh(std::move(vcl), std::move(til), std::move(sml)), registry),
+        FieldList()
+    };
+
+  }
+
+ private:
+
+  // Packet types.
+  static constexpr size_t PACKET_NODE = 1;
+  static constexpr size_t PACKET_ELEMENT = 2;
+  static constexpr size_t PACKET_SUMMARY = 26;
+  static constexpr size_t PACKET_END = 99;
+
+  // Patran element shape code for a tetrahedron.
+  static constexpr size_t SHAPE_TETRAHEDRON = 5;
+
+  // Column widths of the fixed format cards.
+  static constexpr size_t WIDTH_TYPE = 2;
+  static constexpr size_t WIDTH_INT = 8;
+  static constexpr size_t WIDTH_REAL = 16;
+
+  /**
+   * The fields of a packet header card (I2, 8I8).
+   */
+  struct Header {
+    size_t it;
+    size_t id;
+    size_t iv;
+    size_t kc;
+    size_t n1;
+    size_t n2;
+  };
+
+  /**
+   * Read the whole of a file in to a string.
+   * @param file_name the name of the file.
+   * @return the contents of the file.
+   */
+  static std::string
+  read_buffer(const std::string &file_name) {
+
+    std::ifstream fin(file_name, std::ios::binary | std::ios::ate);
+
+    if (!fin) {
+      throw PatranLoaderException("Could not open '" + file_name + "'.");
+    }
+
+    std::string buffer;
+    buffer.resize(static_cast<size_t>(fin.tellg()));
+
+    fin.seekg(0);
+    fin.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    return buffer;
+
+  }
+
+  /**
+   * Retrieve the line starting at `pos' (without the line terminator) and
+   * advance `pos' to the start of the next line.
+   * @param buffer the file buffer.
+   * @param pos the position of the start of the line.
+   * @return a view of the line.
+   */
+  static std::string_view
+  next_line(const std::string &buffer, size_t &pos) {
+
+    const char *begin = buffer.data() + pos;
+    size_t remaining = buffer.size() - pos;
+
+    const void *nl = std::memchr(begin, '\n', remaining);
+    size_t length = nl ? static_cast<const char *>(nl) - begin : remaining;
+
+    pos += nl ? length + 1 : length;
+
+    if (length > 0 && begin[length - 1] == '\r') length--;
+
+    return {begin, length};
+
+  }
+
+  /**
+   * Retrieve a fixed width column of a card, with surrounding blanks removed.
+   * @param line the card.
+   * @param begin the first character of the column.
+   * @param width the width of the column.
+   * @return a view of the column (empty if the card is too short).
+   */
+  static std::string_view
+  column(std::string_view line, size_t begin, size_t width) {
+
+    if (begin >= line.size()) return {};
+
+    std::string_view col = line.substr(begin, width);
+
+    size_t first = col.find_first_not_of(' ');
+    if (first == std::string_view::npos) return {};
+    size_t last = col.find_last_not_of(' ');
+
+    return col.substr(first, last - first + 1);
+
+  }
+
+  /**
+   * Parse an integer column, a blank column is read as zero.
+   * @param line the card.
+   * @param begin the first character of the column.
+   * @param width the width of the column.
+   * @return the integer value.
+   */
+  static size_t
+  parse_int(std::string_view line, size_t begin, size_t width) {
+
+    std::string_view col = column(line, begin, width);
+
+    if (col.empty()) return 0;
+
+    size_t value = 0;
+    auto [ptr, ec] = std::from_chars(col.data(), col.data() + col.size(), value);
+    if (ec != std::errc() || ptr != col.data() + col.size()) {
+      throw PatranLoaderException(
+          "Invalid integer '" + std::string(col) + "'.");
+    }
+
+    return value;
+
+  }
+
+  /**
+   * Parse a real column, Fortran `D' exponents are accepted.
+   * @param line the card.
+   * @param begin the first character of the column.
+   * @param width the width of the column.
+   * @return the real value.
+   */
+  static double
+  parse_real(std::string_view line, size_t begin, size_t width) {
+
+    std::string_view col = column(line, begin, width);
+
+    if (col.empty()) return 0.0;
+
+    // Copy to a small stack buffer so that the exponent can be fixed up.
+    char tmp[WIDTH_REAL];
+    size_t n = col.size();
+    std::copy(col.begin(), col.end(), tmp);
+    for (size_t i = 0; i < n; ++i) {
+      if (tmp[i] == 'D' || tmp[i] == 'd') tmp[i] = 'E';
+    }
+
+    const char *first = tmp;
+    if (*first == '+') first++;
+
+    double value = 0.0;
+    auto [ptr, ec] = std::from_chars(first, tmp + n, value);
+    if (ec != std::errc() || ptr != tmp + n) {
+      throw PatranLoaderException(
+          "Invalid real '" + std::string(col) + "'.");
+    }
+
+    return value;
+
+  }
+
+  /**
+   * Parse a packet header card.
+   * @param line the card.
+   * @return the header.
+   */
+  static Header
+  parse_header(std::string_view line) {
+
+    size_t col = WIDTH_TYPE;
+
+    Header header{};
+    header.it = parse_int(line, 0, WIDTH_TYPE);
+    header.id = parse_int(line, col, WIDTH_INT);
+    header.iv = parse_int(line, col += WIDTH_INT, WIDTH_INT);
+    header.kc = parse_int(line, col += WIDTH_INT, WIDTH_INT);
+    header.n1 = parse_int(line, col += WIDTH_INT, WIDTH_INT);
+    header.n2 = parse_int(line, col += WIDTH_INT, WIDTH_INT);
+
+    return header;
+
+  }
+
+  /**
+   * Walk the packet headers of the file and record where each node and element
+   * packet starts.
+   * @param buffer the file buffer.
+   * @param node_offsets the offsets of the node packets.
+   * @param elem_offsets the offsets of the element packets.
+   */
+  static void
+  index_packets(const std::string &buffer,
+                std::vector<size_t> &node_offsets,
+                std::vector<size_t> &elem_offsets) {
+
+    size_t pos = 0;
+
+    while (pos < buffer.size()) {
+
+      size_t offset = pos;
+      std::string_view line = next_line(buffer, pos);
+
+      if (line.find_first_not_of(' ') == std::string_view::npos) continue;
+
+      Header header = parse_header(line);
+
+      if (header.it == PACKET_END) break;
+
+      switch (header.it) {
+        case PACKET_NODE:
+          node_offsets.push_back(offset);
+          break;
+        case PACKET_ELEMENT:
+          elem_offsets.push_back(offset);
+          break;
+        case PACKET_SUMMARY:
+          node_offsets.reserve(header.n1);
+          elem_offsets.reserve(header.n2);
+          break;
+        default:
+          break;
+      }
+
+      // Skip the data cards.
+      for (size_t i = 0; i < header.kc && pos < buffer.size(); ++i) {
+        next_line(buffer, pos);
+      }
+
+    }
+
+  }
+
+  /**
+   * Decode a node packet.
+   * @param buffer the file buffer.
+   * @param offset the offset of the packet header.
+   * @param id the node id.
+   * @param v the node coordinates.
+   */
+  static void
+  decode_node(const std::string &buffer, size_t offset, size_t &id, vert &v) {
+
+    std::string_view line = next_line(buffer, offset);
+    Header header = parse_header(line);
+
+    id = header.id;
+
+    line = next_line(buffer, offset);
+    v = {
+        parse_real(line, 0 * WIDTH_REAL, WIDTH_REAL),
+        parse_real(line, 1 * WIDTH_REAL, WIDTH_REAL),
+        parse_real(line, 2 * WIDTH_REAL, WIDTH_REAL)
+    };
+
+  }
+
+  /**
+   * Decode an element packet.
+   * @param buffer the file buffer.
+   * @param offset the offset of the packet header.
+   * @param t the element's node ids.
+   * @param sid the element's submesh index.
+   */
+  static void
+  decode_element(const std::string &buffer,
+                 size_t offset,
+                 tet &t,
+                 size_t &sid) {
+
+    std::string_view line = next_line(buffer, offset);
+    Header header = parse_header(line);
+
+    if (header.iv != SHAPE_TETRAHEDRON) {
+      std::stringstream ss;
+      ss << "Element " << header.id << " is not a tetrahedron.";
+      throw PatranLoaderException(ss.str());
+    }
+
+    line = next_line(buffer, offset);
+    size_t config = parse_int(line, 1 * WIDTH_INT, WIDTH_INT);
+    size_t pid = parse_int(line, 2 * WIDTH_INT, WIDTH_INT);
+
+    sid = pid != 0 ? pid : config;
+
+    line = next_line(buffer, offset);
+    for (size_t i = 0; i < 4; ++i) {
+      t[i] = parse_int(line, i * WIDTH_INT, WIDTH_INT);
+    }
+
+  }
+
+  /**
+   * Replace the node ids in the element list with zero based vertex indices.
+   * @param node_ids the node id of each vertex.
+   * @param til the tetrahedra, on entry holding node ids.
+   */
+  static void
+  renumber(const std::vector<size_t> &node_ids, tet_list &til) {
+
+    constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    // The common case: nodes are numbered 1, 2, ..., n in file order.
+    bool dense = true;
+    for (size_t i = 0; i < node_ids.size(); ++i) {
+      if (node_ids[i] != i + 1) {
+        dense = false;
+        break;
+      }
+    }
+
+    std::vector<size_t> index_of;
+    if (!dense) {
+      size_t max_id = *std::max_element(node_ids.begin(), node_ids.end());
+      index_of.assign(max_id + 1, npos);
+      for (size_t i = 0; i < node_ids.size(); ++i) {
+        index_of[node_ids[i]] = i;
+      }
+    }
+
+    parallel_for(til.size(), [&](size_t begin, size_t end) {
+      for (size_t e = begin; e < end; ++e) {
+        for (auto &v : til[e]) {
+          size_t idx = npos;
+          if (dense) {
+            if (v >= 1 && v <= node_ids.size()) idx = v - 1;
+          } else if (v < index_of.size()) {
+            idx = index_of[v];
+          }
+          if (idx == npos) {
+            std::stringstream ss;
+            ss << "Element " << e + 1 << " references unknown node " << v
+               << ".";
+            throw PatranLoaderException(ss.str());
+          }
+          v = idx;
+        }
+      }
+    });
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_LOADER_PATRAN_HPP_
@@ -7,18 +7,25 @@
 
 #include <exception>
 #include <array>
+#include <cctype>
+#include <charconv>
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <memory_resource>
 #include <optional>
 #include <regex>
+#include <span>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
 
 #include "utilities.hpp"
+#include "vector_array.hpp"
 #include "fraction.hpp"
+#include "mesh_registry.hpp"
 #include "model.hpp"
 #include "field.hpp"
 
@@ -58,7 +65,14 @@ class TecplotData {
 
  public:
 
-  TecplotData() = default;
+  /**
+   * Create an empty object whose (temporary) arrays are allocated from a
+   * memory resource.
+   * @param resource the memory resource, e.g. an Arena's.
+   */
+  explicit
+  TecplotData(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) :
+      _xyz(resource), _tetra_submesh_idxs(resource), _tetra_idxs(resource), _m(resource) {}
 
   [[nodiscard]] size_t n_verts() const { return _n_verts.value(); }
 
@@ -68,35 +82,61 @@ class TecplotData {
 
   [[nodiscard]] std::chrono::minutes processing_time() const { return _processing_time; };
 
-  [[nodiscard]] const std::vector<double> &x() const { return _x; }
+  [[nodiscard]] std::span<const double> x() const { return component(_xyz, 0); }
 
-  [[nodiscard]] const std::vector<double> &y() const { return _y; }
+  [[nodiscard]] std::span<const double> y() const { return component(_xyz, 1); }
 
-  [[nodiscard]] const std::vector<double> &z() const { return _z; }
+  [[nodiscard]] std::span<const double> z() const { return component(_xyz, 2); }
 
-  [[nodiscard]] const std::vector<size_t> &tetra_submesh_idxs() const { return _tetra_submesh_idxs; }
+  [[nodiscard]] const std::pmr::vector<size_t> &tetra_submesh_idxs() const { return _tetra_submesh_idxs; }
 
-  [[nodiscard]] const std::vector<size_t> &tetra_idxs() const { return _tetra_idxs; }
+  [[nodiscard]] const std::pmr::vector<size_t> &tetra_idxs() const { return _tetra_idxs; }
 
-  [[nodiscard]] const std::vector<std::vector<double>> &mx() const { return _mx; }
+  [[nodiscard]] std::span<const double> mx(size_t zone_idx) const { return component(_m[zone_idx], 0); }
 
-  [[nodiscard]] const std::vector<std::vector<double>> &my() const { return _my; }
+  [[nodiscard]] std::span<const double> my(size_t zone_idx) const { return component(_m[zone_idx], 1); }
 
-  [[nodiscard]] const std::vector<std::vector<double>> &mz() const { return _mz; }
+  [[nodiscard]] std::span<const double> mz(size_t zone_idx) const { return component(_m[zone_idx], 2); }
 
   [[nodiscard]] std::vector<std::array<double, 3>>
   get_verts() const {
 
+    VectorView view = get_vertex_view();
+
     std::vector<std::array<double, 3>> verts(n_verts());
 
     for (size_t i = 0; i < n_verts(); ++i) {
-      verts[i] = {_x[i], _y[i], _z[i]};
+      verts[i] = view[i];
     }
 
     return verts;
 
   }
 
+  /**
+   * Retrieve a (SoA) view of the vertices, the file's own layout, without
+   * copying; valid for as long as this object. Use `VectorArray<Layout>(view)'
+   * for a copy in another layout.
+   */
+  [[nodiscard]] VectorView
+  get_vertex_view() const {
+
+    return {_xyz.data(), n_verts(), n_verts()};
+
+  }
+
+  /**
+   * Retrieve a (SoA) view of the vectors of a zone's field, without copying;
+   * valid for as long as this object.
+   * @param zone_idx the zone index.
+   */
+  [[nodiscard]] VectorView
+  get_field_view(size_t zone_idx) const {
+
+    return {_m[zone_idx].data(), n_verts(), n_verts()};
+
+  }
+
   [[nodiscard]] std::vector<std::array<size_t, 4>>
   get_elements() const {
 
@@ -131,17 +171,17 @@ class TecplotData {
   [[nodiscard]] FieldList
   get_fields() const {
 
-    FieldList field_list;
+    // One contiguous block for every zone's field.
+    FieldList field_list(n_zones(), n_verts());
 
     for (size_t zone_idx = 0; zone_idx < n_zones(); ++zone_idx) {
 
-      fv_list field(n_verts());
+      VectorView view = get_field_view(zone_idx);
+      auto field = field_list.fields()[zone_idx].vectors();
       for (size_t i = 0; i < n_verts(); ++i) {
-        field[i] = {_mx[zone_idx][i], _my[zone_idx][i], _mz[zone_idx][i]};
+        field[i] = view[i];
       }
 
-      field_list.add_field(Field{field});
-
     }
 
     return field_list;
@@ -234,16 +274,14 @@ class TecplotData {
 
   std::optional<size_t> _current_field_idx;
 
-  std::vector<double> _x;
-  std::vector<double> _y;
-  std::vector<double> _z;
+  // The vertex coordinates as read (SoA): every x, then every y, then every z.
+  std::pmr::vector<double> _xyz;
 
-  std::vector<size_t> _tetra_submesh_idxs;
-  std::vector<size_t> _tetra_idxs;
+  std::pmr::vector<size_t> _tetra_submesh_idxs;
+  std::pmr::vector<size_t> _tetra_idxs;
 
-  std::vector<std::vector<double>> _mx;
-  std::vector<std::vector<double>> _my;
-  std::vector<std::vector<double>> _mz;
+  // Each zone's field vectors as read (SoA).
+  std::pmr::vector<std::pmr::vector<double>> _m;
 
   std::vector<std::string> _zone_titles;
 
@@ -251,28 +289,32 @@ class TecplotData {
 
   friend class TecplotReader;
 
-  [[nodiscard]] bool x_is_full() const {
-    return _x.size() >= _n_verts.value();
+  [[nodiscard]] bool xyz_is_full() const {
+    return _xyz.size() >= 3 * _n_verts.value();
   }
 
-  [[nodiscard]] bool y_is_full() const {
-    return _y.size() >= _n_verts.value();
+  [[nodiscard]] bool current_m_is_full() const {
+    return _m[_current_field_idx.value()].size() >= 3 * _n_verts.value();
   }
 
-  [[nodiscard]] bool z_is_full() const {
-    return _z.size() >= _n_verts.value();
-  }
+  /**
+   * Start the next zone's field, with room for all of its vectors up front:
+   * buffers are never regrown, which matters for a monotonic arena (which
+   * would keep every abandoned buffer until it is reset).
+   */
+  void next_field() {
 
-  [[nodiscard]] bool current_mx_is_full() const {
-    return _mx[_current_field_idx.value()].size() >= _n_verts.value();
-  };
+    _current_field_idx = _current_field_idx.has_value() ? _current_field_idx.value() + 1 : 0;
+    _m.emplace_back().reserve(3 * _n_verts.value());
 
-  [[nodiscard]] bool current_my_is_full() const {
-    return _my[_current_field_idx.value()].size() >= _n_verts.value();
   }
 
-  [[nodiscard]] bool current_mz_is_full() const {
-    return _mz[_current_field_idx.value()].size() >= _n_verts.value();
+  /**
+   * Retrieve one component of an SoA list of n_verts vectors.
+   */
+  [[nodiscard]] std::span<const double>
+  component(const std::pmr::vector<double> &soa, size_t c) const {
+    return {soa.data() + c * n_verts(), n_verts()};
   }
 
   [[nodiscard]] bool tetra_submesh_idx_is_full() const {
@@ -294,23 +336,21 @@ class TecplotData {
   void validate_object() {
 
     // The number of vertices must be consistent.
-    if (_n_verts.value() != _x.size()) throw XCountException();
-    if (_n_verts.value() != _y.size()) throw YCountException();
-    if (_n_verts.value() != _z.size()) throw ZCountException();
+    if (_xyz.size() < 1 * _n_verts.value()) throw XCountException();
+    if (_xyz.size() < 2 * _n_verts.value()) throw YCountException();
+    if (_xyz.size() != 3 * _n_verts.value()) throw ZCountException();
 
     // The number of elements must be consistent.
     if (4*_n_elems.value() != _tetra_idxs.size()) throw TetraIdxCountException();
     if (_n_elems.value() != _tetra_submesh_idxs.size()) throw TetraSubmeshIdxCountException();
 
     // Check that the number of zones is consistent.
-    if (_n_zones.value() != _mx.size()) throw MxZoneCountException();
-    if (_n_zones.value() != _my.size()) throw MyZoneCountException();
-    if (_n_zones.value() != _mz.size()) throw MzZoneCountException();
+    if (_n_zones.value() != _m.size()) throw MxZoneCountException();
 
     for (size_t i = 0; i < _n_zones; ++i) {
-      if (_mx[i].size() != _n_verts.value()) throw MxComponentCountException();
-      if (_my[i].size() != _n_verts.value()) throw MyComponentCountException();
-      if (_mz[i].size() != _n_verts.value()) throw MzComponentCountException();
+      if (_m[i].size() < 1 * _n_verts.value()) throw MxComponentCountException();
+      if (_m[i].size() < 2 * _n_verts.value()) throw MyComponentCountException();
+      if (_m[i].size() != 3 * _n_verts.value()) throw MzComponentCountException();
     }
 
   }
@@ -332,12 +372,42 @@ class TecplotFileLoader {
   /**
  * Function that will read a file and produce a Model object.
  * @param file_name the name of the file.
+ * @param registry if given, the mesh is shared with earlier loads of the same
+ *                 mesh.
+ * @param resource the memory resource for the loader's temporaries, e.g. an
+ *                 Arena's (the model itself is allocated normally).
  * @return a new model object, this object will only contain Mesh information.
  */
   static Model
-  read(const std::string &file_name) {
+  read(const std::string &file_name,
+       MeshRegistry *registry = nullptr,
+       std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+
+    TecplotData curves = read_data(file_name, resource);
+
+    return {
+      MeshRegistry::share(
+          Mesh(curves.get_verts(), curves.get_elements(), curves.get_submesh_idxs()),
+          registry
+      ),
+      curves.get_fields()
+    };
+
+  }
+
+  /**
+   * Function that will read a file in to per-component (SoA) lists, use this
+   * with `TecplotData::get_vertex_view' and `TecplotData::get_field_view' to
+   * use the data without copying it.
+   * @param file_name the name of the file.
+   * @param resource the memory resource to allocate the data from.
+   * @return the data of the file.
+   */
+  static TecplotData
+  read_data(const std::string &file_name,
+            std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
 
-    TecplotData curves;
+    TecplotData curves(resource);
 
     std::string line;
     std::fstream fin(file_name);
@@ -353,6 +423,9 @@ class TecplotFileLoader {
     std::smatch match_int_line;
     std::smatch match_float_line;
 
+    // The tokens of the current line (views in to it), reused line to line.
+    std::vector<std::string_view> str_values;
+
     auto start = std::chrono::high_resolution_clock::now();
 
     while (std::getline(fin, line)) {
@@ -380,18 +453,9 @@ class TecplotFileLoader {
           curves._tetra_idxs.reserve(4 * curves._n_elems.value());
           curves._tetra_submesh_idxs.reserve(curves._n_elems.value());
 
-          curves._x.reserve(curves._n_verts.value());
-          curves._y.reserve(curves._n_verts.value());
-          curves._z.reserve(curves._n_verts.value());
+          curves._xyz.reserve(3 * curves._n_verts.value());
 
-          curves._current_field_idx = 0;
-          curves._mx.emplace_back();
-          curves._my.emplace_back();
-          curves._mz.emplace_back();
-
-          curves._mx[curves._current_field_idx.value()].reserve(curves._n_verts.value());
-          curves._my[curves._current_field_idx.value()].reserve(curves._n_verts.value());
-          curves._mz[curves._current_field_idx.value()].reserve(curves._n_verts.value());
+          curves.next_field();
 
         } else {
 
@@ -410,14 +474,7 @@ class TecplotFileLoader {
             }
           }
 
-          curves._current_field_idx.value()++;
-          curves._mx.emplace_back();
-          curves._my.emplace_back();
-          curves._mz.emplace_back();
-
-          curves._mx[curves._current_field_idx.value()].reserve(curves._n_verts.value());
-          curves._my[curves._current_field_idx.value()].reserve(curves._n_verts.value());
-          curves._mz[curves._current_field_idx.value()].reserve(curves._n_verts.value());
+          curves.next_field();
 
         }
 
@@ -437,16 +494,16 @@ class TecplotFileLoader {
 
       if (std::regex_match(line, match_int_line, _regex_int_line)) {
 
-        std::vector<std::string> str_values = regex_split(line);
+        split_whitespace(line, str_values);
 
         if (zone_counter == 1) {
 
           for (const auto &str_value : str_values) {
             if (!str_value.empty()) {
               if (!curves.tetra_submesh_idx_is_full()) {
-                curves._tetra_submesh_idxs.push_back(std::stoull(str_value));
+                curves._tetra_submesh_idxs.push_back(to_size(str_value));
               } else if (!curves.tetra_idx_is_full()) {
-                curves._tetra_idxs.push_back(std::stoull(str_value) - 1);
+                curves._tetra_idxs.push_back(to_size(str_value) - 1);
               } else {
                 throw std::runtime_error("Too many integers for zone.");
               }
@@ -473,7 +530,7 @@ class TecplotFileLoader {
 
 //      std::cout << "FLOAT LINE: " << line << "\n";
 
-        std::vector<std::string> str_values = regex_split(line);
+        split_whitespace(line, str_values);
 
         if (zone_counter == 1) {
 
@@ -481,21 +538,11 @@ class TecplotFileLoader {
 
           for (const auto &str_value : str_values) {
             if (!str_value.empty()) {
-              if (!curves.x_is_full()) {
-                curves._x.push_back(std::stod(str_value));
-              } else if (!curves.y_is_full()) {
-                curves._y.push_back(std::stod(str_value));
-              } else if (!curves.z_is_full()) {
-                curves._z.push_back(std::stod(str_value));
-              } else if (!curves.current_mx_is_full()) {
-                curves._mx[curves._current_field_idx.value()].push_back(
-                    std::stod(str_value));
-              } else if (!curves.current_my_is_full()) {
-                curves._my[curves._current_field_idx.value()].push_back(
-                    std::stod(str_value));
-              } else if (!curves.current_mz_is_full()) {
-                curves._mz[curves._current_field_idx.value()].push_back(
-                    std::stod(str_value));
+              if (!curves.xyz_is_full()) {
+                curves._xyz.push_back(to_double(str_value));
+              } else if (!curves.current_m_is_full()) {
+                curves._m[curves._current_field_idx.value()].push_back(
+                    to_double(str_value));
               } else {
                 throw std::runtime_error("Too many doubles for zone.");
               }
@@ -508,15 +555,9 @@ class TecplotFileLoader {
 
           for (const auto &str_value : str_values) {
             if (!str_value.empty()) {
-              if (!curves.current_mx_is_full()) {
-                curves._mx[curves._current_field_idx.value()].push_back(
-                    std::stod(str_value));
-              } else if (!curves.current_my_is_full()) {
-                curves._my[curves._current_field_idx.value()].push_back(
-                    std::stod(str_value));
-              } else if (!curves.current_mz_is_full()) {
-                curves._mz[curves._current_field_idx.value()].push_back(
-                    std::stod(str_value));
+              if (!curves.current_m_is_full()) {
+                curves._m[curves._current_field_idx.value()].push_back(
+                    to_double(str_value));
               } else {
                 throw std::runtime_error("Too many doubles for zone.");
               }
@@ -538,17 +579,67 @@ class TecplotFileLoader {
 
     curves.finish_object();
 
-    return {
-      curves.get_verts(),
-      curves.get_elements(),
-      curves.get_submesh_idxs(),
-      curves.get_fields()
-    };
+    return curves;
 
   }
 
  private:
 
+  /**
+   * Split a line in to its whitespace separated tokens, without allocating
+   * (once `tokens' has grown to the longest line).
+   * @param line the line.
+   * @param tokens the tokens, views in to the line.
+   */
+  static void
+  split_whitespace(const std::string &line, std::vector<std::string_view> &tokens) {
+
+    tokens.clear();
+
+    size_t i = 0;
+    while (i < line.size()) {
+      while (i < line.size() && std::isspace(static_cast<unsigned char>(line[i]))) ++i;
+      size_t first = i;
+      while (i < line.size() && !std::isspace(static_cast<unsigned char>(line[i]))) ++i;
+      if (i > first) tokens.emplace_back(line.data() + first, i - first);
+    }
+
+  }
+
+  /**
+   * Parse a floating point token (as matched by the float line regex).
+   */
+  static double
+  to_double(std::string_view token) {
+
+    if (!token.empty() && token[0] == '+') token.remove_prefix(1);
+
+    double value;
+    auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (error != std::errc() || end != token.data() + token.size()) {
+      throw TecplotFileLoaderException("Could not parse floating point value: " + std::string(token));
+    }
+
+    return value;
+
+  }
+
+  /**
+   * Parse an unsigned integer token.
+   */
+  static size_t
+  to_size(std::string_view token) {
+
+    size_t value;
+    auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (error != std::errc() || end != token.data() + token.size()) {
+      throw TecplotFileLoaderException("Could not parse integer value: " + std::string(token));
+    }
+
+    return value;
+
+  }
+
   /**
    * Return a regular expression that will match a zone line.
    */
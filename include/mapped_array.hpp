@@ -0,0 +1,299 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_MAPPED_ARRAY_HPP_
+#define MFC_INCLUDE_MAPPED_ARRAY_HPP_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class MappedArrayException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  MappedArrayException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * Access pattern hints for a mapped array.
+ */
+enum class MappedAccess {
+  NORMAL,
+  SEQUENTIAL,  // read ahead aggressively, drop pages behind
+  RANDOM       // no read ahead
+};
+
+/**
+ * A fixed size array of trivially copyable values backed by a file that is
+ * memory mapped (shared), so that it can be larger than physical memory: the
+ * kernel pages it in and out on demand. Access hints and `release' (which
+ * drops a range's pages once it has been filled or consumed) keep the
+ * resident set small when an array is streamed through in blocks.
+ */
+template<typename T>
+class MappedArray {
+
+  static_assert(std::is_trivially_copyable_v<T>);
+
+ public:
+
+  /**
+   * Create an empty (unmapped) array.
+   */
+  MappedArray() = default;
+
+  /**
+   * Create a new backing file (truncating an existing one) of `n' values.
+   * @param path the path of the file.
+   * @param n the number of values.
+   * @return the array.
+   */
+  static MappedArray
+  create(const std::string &path, size_t n) {
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) fail("Could not create '" + path + "'");
+
+    if (::ftruncate(fd, static_cast<off_t>(n * sizeof(T))) != 0) {
+      ::close(fd);
+      fail("Could not size '" + path + "'");
+    }
+
+    return {path, fd, n, true};
+
+  }
+
+  /**
+   * Map an existing backing file.
+   * @param path the path of the file.
+   * @param writable if true, the array may be modified.
+   * @return the array.
+   */
+  static MappedArray
+  open(const std::string &path, bool writable = false) {
+
+    int fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) fail("Could not open '" + path + "'");
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      fail("Could not stat '" + path + "'");
+    }
+
+    return {path, fd, static_cast<size_t>(st.st_size) / sizeof(T), writable};
+
+  }
+
+  MappedArray(const MappedArray &) = delete;
+
+  MappedArray &operator=(const MappedArray &) = delete;
+
+  MappedArray(MappedArray &&other) noexcept { swap(other); }
+
+  MappedArray &
+  operator=(MappedArray &&other) noexcept {
+
+    if (this != &other) {
+      MappedArray tmp;
+      tmp.swap(other);
+      swap(tmp);
+    }
+
+    return *this;
+
+  }
+
+  ~MappedArray() {
+
+    if (_data) ::munmap(_data, bytes());
+    if (_fd >= 0) ::close(_fd);
+
+  }
+
+  /**
+   * Retrieve the number of values.
+   */
+  [[nodiscard]] size_t
+  size() const { return _size; }
+
+  /**
+   * Retrieve the path of the backing file.
+   */
+  [[nodiscard]] const std::string &
+  path() const { return _path; }
+
+  [[nodiscard]] T *
+  data() { return _data; }
+
+  [[nodiscard]] const T *
+  data() const { return _data; }
+
+  [[nodiscard]] std::span<T>
+  span() { return {_data, _size}; }
+
+  [[nodiscard]] std::span<const T>
+  span() const { return {_data, _size}; }
+
+  T &
+  operator[](size_t i) { return _data[i]; }
+
+  const T &
+  operator[](size_t i) const { return _data[i]; }
+
+  /**
+   * Hint how the whole array will be accessed.
+   * @param access the access pattern.
+   */
+  void
+  advise(MappedAccess access) const {
+
+    if (!_data) return;
+
+    int advice = access == MappedAccess::SEQUENTIAL ? MADV_SEQUENTIAL
+               : access == MappedAccess::RANDOM ? MADV_RANDOM
+               : MADV_NORMAL;
+    ::madvise(_data, bytes(), advice);
+
+  }
+
+  /**
+   * Ask for a range to be read in ahead of use.
+   * @param first the first value.
+   * @param count the number of values.
+   */
+  void
+  will_need(size_t first, size_t count) const {
+
+    if (auto [p, n] = pages(first, count); n > 0) ::madvise(p, n, MADV_WILLNEED);
+
+  }
+
+  /**
+   * Drop a range's pages from the resident set, once it has been filled or
+   * consumed. Modified pages are written back first.
+   * @param first the first value.
+   * @param count the number of values.
+   */
+  void
+  release(size_t first, size_t count) const {
+
+    auto [p, n] = pages(first, count);
+    if (n == 0) return;
+
+    if (_writable) ::msync(p, n, MS_SYNC);
+    ::madvise(p, n, MADV_DONTNEED);
+    ::posix_fadvise(_fd, static_cast<char *>(p) - reinterpret_cast<char *>(_data),
+                    static_cast<off_t>(n), POSIX_FADV_DONTNEED);
+
+  }
+
+  /**
+   * Write every modified page back to the file.
+   */
+  void
+  flush() const {
+
+    if (_data && _writable) ::msync(_data, bytes(), MS_SYNC);
+
+  }
+
+ private:
+
+  std::string _path;
+
+  int _fd = -1;
+
+  T *_data = nullptr;
+
+  size_t _size = 0;
+
+  bool _writable = false;
+
+  MappedArray(std::string path, int fd, size_t n, bool writable) :
+      _path(std::move(path)), _fd(fd), _size(n), _writable(writable) {
+
+    if (n == 0) return;
+
+    void *p = ::mmap(nullptr, bytes(), writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                     MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+      ::close(fd);
+      _fd = -1;
+      fail("Could not map '" + _path + "'");
+    }
+
+    _data = static_cast<T *>(p);
+
+  }
+
+  [[nodiscard]] size_t
+  bytes() const { return _size * sizeof(T); }
+
+  /**
+   * Retrieve the whole pages covering a range, clipped to the mapping.
+   */
+  [[nodiscard]] std::pair<void *, size_t>
+  pages(size_t first, size_t count) const {
+
+    if (!_data || count == 0) return {nullptr, 0};
+
+    auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t begin = first * sizeof(T) / page * page;
+    size_t end = std::min(bytes(), (first + count) * sizeof(T));
+
+    return {reinterpret_cast<char *>(_data) + begin, end - begin};
+
+  }
+
+  void
+  swap(MappedArray &other) noexcept {
+
+    std::swap(_path, other._path);
+    std::swap(_fd, other._fd);
+    std::swap(_data, other._data);
+    std::swap(_size, other._size);
+    std::swap(_writable, other._writable);
+
+  }
+
+  [[noreturn]] static void
+  fail(const std::string &message) {
+
+    throw MappedArrayException(message + ": " + std::strerror(errno));
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_MAPPED_ARRAY_HPP_
@@ -0,0 +1,46 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_MAPPED_MODEL_HPP_
+#define MFC_INCLUDE_MAPPED_MODEL_HPP_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "aliases.hpp"
+#include "mapped_array.hpp"
+
+/**
+ * An out-of-core model: the mesh and fields of a Model, each held in a file
+ * backed MappedArray so that models larger than memory can be converted and
+ * processed. The arrays are filled and drained in blocks by
+ * `MicromagFileLoader::read_mapped' and `MicromagFileWriter::write_mapped'.
+ */
+struct MappedModel {
+
+  // Vertex coordinates.
+  MappedArray<vert> vcl;
+
+  // Tetrahedra (vertex indices).
+  MappedArray<tet> til;
+
+  // Submesh id of each tetrahedron.
+  MappedArray<size_t> sml;
+
+  // The original index of each vertex (reordered meshes only, else empty).
+  MappedArray<size_t> vertex_ids;
+
+  // The original index of each element (reordered meshes only, else empty).
+  MappedArray<size_t> element_ids;
+
+  // The content hash that the mesh was tagged with (see `mesh_hash'), if any.
+  std::optional<uint64_t> hash;
+
+  // One array of vectors (one per vertex) for each field.
+  std::vector<MappedArray<fv>> fields;
+
+};
+
+#endif //MFC_INCLUDE_MAPPED_MODEL_HPP_
@@ -41,6 +41,27 @@ class Mesh {
       _sml(std::move(sml))
       {}
 
+  /**
+   * Constructor will create a new mesh whose vertices and elements have been
+   * reordered, remembering the original index of each.
+   * @param vcl the (v)ertex (c)oordinate (l)ist.
+   * @param til the (t)etrahedra (i)ndex (l)ist.
+   * @param sml the (s)ub-(m)esh list.
+   * @param vertex_ids the original index of each vertex.
+   * @param element_ids the original index of each element.
+   */
+  Mesh(v_list vcl,
+       tet_list til,
+       sm_list sml,
+       vi_list vertex_ids,
+       teti_list element_ids) :
+      _vcl(std::move(vcl)),
+      _til(std::move(til)),
+      _sml(std::move(sml)),
+      _vertex_ids(std::move(vertex_ids)),
+      _element_ids(std::move(element_ids))
+      {}
+
   /**
    * Retrieve the vertex coordinate list.
    * @return the vertex coordinate list.
@@ -74,6 +95,30 @@ class Mesh {
 
   }
 
+  /**
+   * Retrieve the original index of each vertex, empty if the mesh has not
+   * been reordered.
+   * @return the original vertex indices.
+   */
+  [[nodiscard]] const vi_list &
+  vertex_ids() const {
+
+    return _vertex_ids;
+
+  }
+
+  /**
+   * Retrieve the original index of each element, empty if the mesh has not
+   * been reordered.
+   * @return the original element indices.
+   */
+  [[nodiscard]] const teti_list &
+  element_ids() const {
+
+    return _element_ids;
+
+  }
+
  private:
 
   // Vertex list.
@@ -85,6 +130,12 @@ class Mesh {
   // Sub-mesh (index) list.
   sm_list _sml;
 
+  // Original vertex indices (empty if not reordered).
+  vi_list _vertex_ids;
+
+  // Original element indices (empty if not reordered).
+  teti_list _element_ids;
+
 };
 
 #endif //MFC_READMESH_HPP
@@ -0,0 +1,130 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_MESH_HASH_HPP_
+#define MFC_INCLUDE_MESH_HASH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "flat_hash_map.hpp"
+#include "mesh.hpp"
+#include "parallel.hpp"
+
+/**
+ * A fast, non-cryptographic 64-bit content hash. The input is cut in to
+ * chunks of `CHUNK' bytes that are hashed in parallel, four independent
+ * multiply-rotate lanes per chunk (as in xxHash), and the chunk hashes are
+ * then combined in order, so the result does not depend on the number of
+ * threads.
+ */
+class ContentHash {
+
+ public:
+
+  // The number of bytes per (parallel) chunk.
+  static constexpr size_t CHUNK = size_t{1} << 20;
+
+  /**
+   * Hash a run of bytes.
+   * @param data the bytes.
+   * @param seed the seed.
+   * @return the hash.
+   */
+  static uint64_t
+  bytes(std::span<const std::byte> data, uint64_t seed = 0) {
+
+    size_t n_chunks = (data.size() + CHUNK - 1) / CHUNK;
+
+    std::vector<uint64_t> chunk_hashes(n_chunks);
+    parallel_for(n_chunks, [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        chunk_hashes[c] = chunk(data.subspan(c * CHUNK, std::min(CHUNK, data.size() - c * CHUNK)));
+      }
+    });
+
+    uint64_t h = mix64(seed ^ (data.size() * P1));
+    for (auto ch : chunk_hashes) h = mix64(h ^ (ch + P2 + (h << 6) + (h >> 2)));
+
+    return h;
+
+  }
+
+  /**
+   * Hash the contents of a vector of trivially copyable values.
+   * @param values the values.
+   * @param seed the seed.
+   * @return the hash.
+   */
+  template<typename T>
+  static uint64_t
+  values(const std::vector<T> &values, uint64_t seed = 0) {
+
+    return bytes(std::as_bytes(std::span<const T>(values)), seed);
+
+  }
+
+ private:
+
+  static constexpr uint64_t P1 = 0x9e3779b185ebca87ULL;
+  static constexpr uint64_t P2 = 0xc2b2ae3d27d4eb4fULL;
+
+  static uint64_t
+  rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+  static uint64_t
+  round(uint64_t acc, uint64_t word) { return rotl(acc + word * P2, 31) * P1; }
+
+  /**
+   * Hash one chunk.
+   */
+  static uint64_t
+  chunk(std::span<const std::byte> data) {
+
+    uint64_t lane[4] = {P1 + P2, P2, 0, 0 - P1};
+
+    size_t i = 0;
+    for (; i + 32 <= data.size(); i += 32) {
+      for (size_t l = 0; l < 4; ++l) {
+        uint64_t word;
+        std::memcpy(&word, data.data() + i + 8 * l, 8);
+        lane[l] = round(lane[l], word);
+      }
+    }
+
+    uint64_t h = rotl(lane[0], 1) + rotl(lane[1], 7) + rotl(lane[2], 12) + rotl(lane[3], 18);
+    for (; i < data.size(); ++i) {
+      h = round(h, static_cast<uint64_t>(data[i]));
+    }
+
+    return mix64(h);
+
+  }
+
+};
+
+/**
+ * Hash the contents of a mesh: its vertices, elements, submesh ids and (if
+ * reordered) original vertex and element indices.
+ * @param mesh the mesh.
+ * @return the hash.
+ */
+inline uint64_t
+mesh_hash(const Mesh &mesh) {
+
+  uint64_t h = ContentHash::values(mesh.vcl(), 1);
+  h = ContentHash::values(mesh.til(), h);
+  h = ContentHash::values(mesh.sml(), h);
+  h = ContentHash::values(mesh.vertex_ids(), h);
+  h = ContentHash::values(mesh.element_ids(), h);
+
+  return h;
+
+}
+
+#endif //MFC_INCLUDE_MESH_HASH_HPP_
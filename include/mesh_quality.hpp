@@ -0,0 +1,573 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_MESH_QUALITY_HPP_
+#define MFC_INCLUDE_MESH_QUALITY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "aliases.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "parallel.hpp"
+#include "vector_array.hpp"
+
+/**
+ * The quality measures of a tetrahedron. All but the volume are 1 (or
+ * 70.53 degrees for the dihedral angle) for a regular tetrahedron.
+ */
+struct TetQuality {
+
+  // Signed volume, positive if the vertices are right handed.
+  double volume = 0.0;
+
+  // Longest edge over 2 sqrt(6) times the inradius (1 to infinity).
+  double aspect_ratio = 0.0;
+
+  // Three times the inradius over the circumradius (0 to 1).
+  double radius_ratio = 0.0;
+
+  // Smallest dihedral angle, in degrees.
+  double min_dihedral = 0.0;
+
+  // Longest edge over shortest edge (1 to infinity).
+  double edge_ratio = 0.0;
+
+};
+
+/**
+ * Summary statistics and a histogram of one quality measure.
+ */
+struct QualitySummary {
+
+  // Histogram range, values outside it (including infinities) are counted in
+  // the first/last bin (no histogram is kept if there are no bins).
+  double lo = 0.0;
+  double hi = 1.0;
+
+  size_t count = 0;
+
+  // NaN values, which are left out of everything else.
+  size_t n_nan = 0;
+
+  double min = std::numeric_limits<double>::infinity();
+
+  double max = -std::numeric_limits<double>::infinity();
+
+  double sum = 0.0;
+
+  std::vector<size_t> histogram;
+
+  /**
+   * Retrieve the mean value.
+   */
+  [[nodiscard]] double
+  mean() const { return count > 0 ? sum / (double) count : 0.0; }
+
+  /**
+   * Add a value.
+   */
+  void
+  add(double value) {
+
+    if (std::isnan(value)) {
+      n_nan++;
+      return;
+    }
+
+    count++;
+    min = std::min(min, value);
+    max = std::max(max, value);
+    sum += value;
+
+    if (histogram.empty()) return;
+
+    // Clamp before converting, the conversion of an out of range double is
+    // undefined.
+    double n = (double) histogram.size();
+    double x = (value - lo) / (hi - lo) * n;
+    size_t bin = x <= 0.0 ? 0 : x >= n ? histogram.size() - 1 : (size_t) x;
+    histogram[bin]++;
+
+  }
+
+  /**
+   * Add the values of another summary (with the same range and bins).
+   */
+  void
+  merge(const QualitySummary &other) {
+
+    count += other.count;
+    n_nan += other.n_nan;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    sum += other.sum;
+    for (size_t b = 0; b < histogram.size(); ++b) histogram[b] += other.histogram[b];
+
+  }
+
+};
+
+/**
+ * The quality summaries of a submesh (or of the whole mesh).
+ */
+struct SubmeshQuality {
+
+  size_t submesh_id = 0;
+
+  size_t n_tets = 0;
+
+  // Tetrahedra with zero or negative volume.
+  size_t n_inverted = 0;
+
+  QualitySummary volume;
+
+  QualitySummary aspect_ratio;
+
+  QualitySummary radius_ratio;
+
+  QualitySummary min_dihedral;
+
+  QualitySummary edge_ratio;
+
+  /**
+   * Create empty summaries with a number of histogram bins.
+   */
+  explicit SubmeshQuality(size_t submesh_id = 0, size_t n_bins = 20) :
+      submesh_id(submesh_id) {
+
+    init(volume, 0.0, 0.0, 0);
+    init(aspect_ratio, 1.0, 10.0, n_bins);
+    init(radius_ratio, 0.0, 1.0, n_bins);
+    init(min_dihedral, 0.0, 90.0, n_bins);
+    init(edge_ratio, 1.0, 10.0, n_bins);
+
+  }
+
+  /**
+   * Add a tetrahedron's quality.
+   */
+  void
+  add(const TetQuality &q) {
+
+    n_tets++;
+    if (q.volume <= 0.0) n_inverted++;
+    volume.add(q.volume);
+    aspect_ratio.add(q.aspect_ratio);
+    radius_ratio.add(q.radius_ratio);
+    min_dihedral.add(q.min_dihedral);
+    edge_ratio.add(q.edge_ratio);
+
+  }
+
+  /**
+   * Add the tetrahedra of another submesh summary.
+   */
+  void
+  merge(const SubmeshQuality &other) {
+
+    n_tets += other.n_tets;
+    n_inverted += other.n_inverted;
+    volume.merge(other.volume);
+    aspect_ratio.merge(other.aspect_ratio);
+    radius_ratio.merge(other.radius_ratio);
+    min_dihedral.merge(other.min_dihedral);
+    edge_ratio.merge(other.edge_ratio);
+
+  }
+
+ private:
+
+  static void
+  init(QualitySummary &summary, double lo, double hi, size_t n_bins) {
+    summary.lo = lo;
+    summary.hi = hi;
+    summary.histogram.assign(n_bins, 0);
+  }
+
+};
+
+/**
+ * The quality of a mesh: one summary per submesh and one for the whole mesh.
+ */
+struct QualityReport {
+
+  std::vector<SubmeshQuality> submeshes;
+
+  SubmeshQuality total;
+
+  /**
+   * Print the summary statistics and, optionally, the histograms.
+   * @param out the output stream.
+   * @param histograms if true, also print the histograms.
+   */
+  void
+  print(std::ostream &out, bool histograms = false) const {
+
+    for (const auto &sq : submeshes) print(out, "submesh " + std::to_string(sq.submesh_id), sq, histograms);
+    print(out, "all", total, histograms);
+
+  }
+
+ private:
+
+  static void
+  print(std::ostream &out, const std::string &title, const SubmeshQuality &sq, bool histograms) {
+
+    out << title << ": " << sq.n_tets << " tets, " << sq.n_inverted << " inverted/degenerate" << std::endl;
+    out << "  " << std::left << std::setw(14) << "measure"
+        << std::right << std::setw(14) << "min"
+        << std::setw(14) << "mean"
+        << std::setw(14) << "max" << std::endl;
+
+    auto row = [&](const std::string &name, const QualitySummary &s) {
+      out << "  " << std::left << std::setw(14) << name << std::right
+          << std::setw(14) << s.min << std::setw(14) << s.mean() << std::setw(14) << s.max;
+      if (s.n_nan > 0) out << "  (" << s.n_nan << " NaN)";
+      out << std::endl;
+      if (!histograms) return;
+      double width = (s.hi - s.lo) / (double) s.histogram.size();
+      for (size_t b = 0; b < s.histogram.size(); ++b) {
+        out << "    [" << std::setw(8) << s.lo + b * width << ", " << std::setw(8) << s.lo + (b + 1) * width << ") "
+            << s.histogram[b] << std::endl;
+      }
+    };
+
+    row("volume", sq.volume);
+    row("aspect_ratio", sq.aspect_ratio);
+    row("radius_ratio", sq.radius_ratio);
+    row("min_dihedral", sq.min_dihedral);
+    row("edge_ratio", sq.edge_ratio);
+
+  }
+
+};
+
+/**
+ * A batch of tetrahedra, one per lane (SoA): their corners and, once
+ * computed, their quality measures. Inputs and outputs are kept in one object
+ * so that the compiler can see that they do not overlap.
+ */
+struct TetQualityBatch {
+
+  static constexpr size_t WIDTH = 8;
+
+  // The corners: x[k][l] is the x coordinate of the k-th corner of the l-th
+  // tetrahedron.
+  alignas(64) double x[4][WIDTH];
+  alignas(64) double y[4][WIDTH];
+  alignas(64) double z[4][WIDTH];
+
+  // The quality measures.
+  alignas(64) double volume[WIDTH];
+  alignas(64) double aspect_ratio[WIDTH];
+  alignas(64) double radius_ratio[WIDTH];
+  alignas(64) double min_dihedral[WIDTH];
+  alignas(64) double edge_ratio[WIDTH];
+
+  /**
+   * Set the corners of a lane.
+   */
+  void
+  set(size_t l, const vert &a, const vert &b, const vert &c, const vert &d) {
+    const vert *v[4] = {&a, &b, &c, &d};
+    for (size_t k = 0; k < 4; ++k) {
+      x[k][l] = (*v[k])[0];
+      y[k][l] = (*v[k])[1];
+      z[k][l] = (*v[k])[2];
+    }
+  }
+
+  /**
+   * Retrieve the quality measures of a lane.
+   */
+  [[nodiscard]] TetQuality
+  operator[](size_t l) const {
+    return {volume[l], aspect_ratio[l], radius_ratio[l], min_dihedral[l], edge_ratio[l]};
+  }
+
+};
+
+/**
+ * Computes the quality measures of the tetrahedra of a mesh. Tetrahedra are
+ * processed in batches of TetQualityBatch::WIDTH: their corners are gathered
+ * in to SoA lanes and the measures are computed lane by lane, in a loop
+ * that the compiler vectorises: with -fno-math-errno (for the square roots)
+ * and -fno-trapping-math (to compute guarded divisions as selects).
+ */
+class MeshQuality {
+
+ public:
+
+  // The number of tetrahedra per batch.
+  static constexpr size_t WIDTH = TetQualityBatch::WIDTH;
+
+  /**
+   * Default constructor.
+   */
+  MeshQuality() = default;
+
+  /**
+   * Compute the quality measures of a tetrahedron.
+   * @param a the first vertex.
+   * @param b the second vertex.
+   * @param c the third vertex.
+   * @param d the fourth vertex.
+   * @return the quality measures.
+   */
+  static TetQuality
+  tet_quality(const vert &a, const vert &b, const vert &c, const vert &d) {
+
+    TetQualityBatch batch;
+    for (size_t l = 0; l < WIDTH; ++l) batch.set(l, a, b, c, d);
+    tet_quality(batch);
+
+    return batch[0];
+
+  }
+
+  /**
+   * Compute the quality measures of a batch of tetrahedra.
+   * @param batch the batch, with its corners set.
+   */
+  static void
+  tet_quality(TetQualityBatch &batch) {
+
+    constexpr double inf = std::numeric_limits<double>::infinity();
+
+    auto &q = batch;
+
+    for (size_t l = 0; l < WIDTH; ++l) {
+
+      double ax = q.x[0][l], ay = q.y[0][l], az = q.z[0][l];
+      double bx = q.x[1][l], by = q.y[1][l], bz = q.z[1][l];
+      double cx = q.x[2][l], cy = q.y[2][l], cz = q.z[2][l];
+      double dx = q.x[3][l], dy = q.y[3][l], dz = q.z[3][l];
+
+      // Edges: e1/e6, e2/e5 and e3/e4 are opposite pairs.
+      double e1x = bx - ax, e1y = by - ay, e1z = bz - az;
+      double e2x = cx - ax, e2y = cy - ay, e2z = cz - az;
+      double e3x = dx - ax, e3y = dy - ay, e3z = dz - az;
+      double e4x = cx - bx, e4y = cy - by, e4z = cz - bz;
+      double e5x = dx - bx, e5y = dy - by, e5z = dz - bz;
+      double e6x = dx - cx, e6y = dy - cy, e6z = dz - cz;
+
+      // Squared edge lengths.
+      double l1 = e1x * e1x + e1y * e1y + e1z * e1z;
+      double l2 = e2x * e2x + e2y * e2y + e2z * e2z;
+      double l3 = e3x * e3x + e3y * e3y + e3z * e3z;
+      double l4 = e4x * e4x + e4y * e4y + e4z * e4z;
+      double l5 = e5x * e5x + e5y * e5y + e5z * e5z;
+      double l6 = e6x * e6x + e6y * e6y + e6z * e6z;
+      double l_min = std::min(std::min(std::min(l1, l2), std::min(l3, l4)), std::min(l5, l6));
+      double l_max = std::max(std::max(std::max(l1, l2), std::max(l3, l4)), std::max(l5, l6));
+
+      // Face area vectors (twice the area), pointing in to the tetrahedron
+      // when the vertices are right handed, opposite vertices a, b, c and d.
+      double nax = e5y * e4z - e5z * e4y, nay = e5z * e4x - e5x * e4z, naz = e5x * e4y - e5y * e4x;
+      double nbx = e2y * e3z - e2z * e3y, nby = e2z * e3x - e2x * e3z, nbz = e2x * e3y - e2y * e3x;
+      double ncx = e3y * e1z - e3z * e1y, ncy = e3z * e1x - e3x * e1z, ncz = e3x * e1y - e3y * e1x;
+      double ndx = e1y * e2z - e1z * e2y, ndy = e1z * e2x - e1x * e2z, ndz = e1x * e2y - e1y * e2x;
+      double area_a = std::sqrt(nax * nax + nay * nay + naz * naz);
+      double area_b = std::sqrt(nbx * nbx + nby * nby + nbz * nbz);
+      double area_c = std::sqrt(ncx * ncx + ncy * ncy + ncz * ncz);
+      double area_d = std::sqrt(ndx * ndx + ndy * ndy + ndz * ndz);
+      double area_sum = (area_a + area_b + area_c + area_d) / 2.0;
+
+      // e3 . (e1 x e2) = e1 . (e2 x e3).
+      double signed_volume = (e3x * ndx + e3y * ndy + e3z * ndz) / 6.0;
+      double volume = std::abs(signed_volume);
+      double r_in = area_sum > 0.0 ? 3.0 * volume / area_sum : 0.0;
+
+      // Circumradius from the products of opposite edge lengths.
+      double p1 = std::sqrt(l1 * l6);
+      double p2 = std::sqrt(l2 * l5);
+      double p3 = std::sqrt(l3 * l4);
+      double s = (p1 + p2 + p3) * (p1 + p2 - p3) * (p1 - p2 + p3) * (-p1 + p2 + p3);
+      double r_circ = volume > 0.0 ? std::sqrt(std::max(s, 0.0)) / (24.0 * volume) : 0.0;
+
+      // The dihedral angle between two faces is pi minus the angle between
+      // their (both inward or both outward) normals; keep the largest cosine
+      // (1 for a degenerate face).
+      auto cos_angle = [](double dot, double denominator) {
+        return denominator > 0.0 ? -dot / denominator : 1.0;
+      };
+      double cos_ab = cos_angle(nax * nbx + nay * nby + naz * nbz, area_a * area_b);
+      double cos_ac = cos_angle(nax * ncx + nay * ncy + naz * ncz, area_a * area_c);
+      double cos_ad = cos_angle(nax * ndx + nay * ndy + naz * ndz, area_a * area_d);
+      double cos_bc = cos_angle(nbx * ncx + nby * ncy + nbz * ncz, area_b * area_c);
+      double cos_bd = cos_angle(nbx * ndx + nby * ndy + nbz * ndz, area_b * area_d);
+      double cos_cd = cos_angle(ncx * ndx + ncy * ndy + ncz * ndz, area_c * area_d);
+
+      q.volume[l] = signed_volume;
+      q.aspect_ratio[l] = r_in > 0.0 ? std::sqrt(l_max) / (2.0 * std::sqrt(6.0) * r_in) : inf;
+      q.radius_ratio[l] = r_circ > 0.0 ? 3.0 * r_in / r_circ : 0.0;
+      q.min_dihedral[l] = std::max(std::max(std::max(cos_ab, cos_ac), std::max(cos_ad, cos_bc)),
+                                   std::max(cos_bd, cos_cd));
+      q.edge_ratio[l] = l_min > 0.0 ? std::sqrt(l_max / l_min) : inf;
+
+    }
+
+    // acos does not vectorise, so convert the cosines afterwards.
+    for (size_t l = 0; l < WIDTH; ++l) q.min_dihedral[l] = dihedral_degrees(q.min_dihedral[l]);
+
+  }
+
+  /**
+   * Compute the quality of every tetrahedron of a mesh.
+   * @param mesh the mesh.
+   * @return the quality of each tetrahedron.
+   */
+  static std::vector<TetQuality>
+  tet_qualities(const Mesh &mesh) {
+
+    const auto &vcl = mesh.vcl();
+    const auto &til = mesh.til();
+
+    std::vector<TetQuality> result(til.size());
+    parallel_for(til.size(), [&](size_t begin, size_t end) {
+      TetQualityBatch batch;
+      for (size_t t = begin; t < end; t += WIDTH) {
+        size_t n = std::min(WIDTH, end - t);
+        gather(vcl, til, t, n, batch);
+        tet_quality(batch);
+        for (size_t l = 0; l < n; ++l) result[t + l] = batch[l];
+      }
+    });
+
+    return result;
+
+  }
+
+  /**
+   * Compute per-submesh quality summaries of a mesh.
+   * @param mesh the mesh.
+   * @param n_bins the number of histogram bins.
+   * @return the quality report.
+   */
+  static QualityReport
+  analyse(const Mesh &mesh, size_t n_bins = 20) {
+
+    return analyse(mesh.vcl(), mesh.til(), mesh.sml(), n_bins);
+
+  }
+
+  /**
+   * Compute per-submesh quality summaries of a mesh whose vertices are held
+   * in any layout: a vertex list or a VectorArray. Each thread accumulates
+   * its own summaries, which are merged at the end, so no per-tetrahedron
+   * results are stored.
+   * @param vertices the vertices.
+   * @param til the tetrahedra.
+   * @param sml the submesh id of each tetrahedron.
+   * @param n_bins the number of histogram bins.
+   * @return the quality report.
+   */
+  template<typename Vertices>
+  static QualityReport
+  analyse(const Vertices &vertices, const tet_list &til, const sm_list &sml, size_t n_bins = 20) {
+
+    // The submesh ids, sorted, and the summary index of each tetrahedron.
+    std::vector<size_t> ids(sml.begin(), sml.end());
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    QualityReport report;
+    report.total = SubmeshQuality(0, n_bins);
+    for (auto id : ids) report.submeshes.emplace_back(id, n_bins);
+
+    std::mutex report_mutex;
+
+    parallel_for(til.size(), [&](size_t begin, size_t end) {
+
+      std::vector<SubmeshQuality> local;
+      for (auto id : ids) local.emplace_back(id, n_bins);
+
+      size_t last_id = std::numeric_limits<size_t>::max();
+      size_t last_idx = 0;
+
+      TetQualityBatch batch;
+
+      for (size_t t = begin; t < end; t += WIDTH) {
+        size_t n = std::min(WIDTH, end - t);
+        gather(vertices, til, t, n, batch);
+        tet_quality(batch);
+        for (size_t l = 0; l < n; ++l) {
+          if (sml[t + l] != last_id) {
+            last_id = sml[t + l];
+            last_idx = std::lower_bound(ids.begin(), ids.end(), last_id) - ids.begin();
+          }
+          local[last_idx].add(batch[l]);
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(report_mutex);
+      for (size_t i = 0; i < local.size(); ++i) report.submeshes[i].merge(local[i]);
+
+    });
+
+    for (const auto &sq : report.submeshes) report.total.merge(sq);
+
+    return report;
+
+  }
+
+ private:
+
+  /**
+   * Gather the corners of tetrahedra t to t + n - 1 in to the lanes of a
+   * batch, the lanes past n repeat the first tetrahedron.
+   */
+  static void
+  gather(const v_list &vcl, const tet_list &til, size_t t, size_t n, TetQualityBatch &batch) {
+
+    for (size_t l = 0; l < WIDTH; ++l) {
+      const auto &tet = til[t + (l < n ? l : 0)];
+      batch.set(l, vcl[tet[0]], vcl[tet[1]], vcl[tet[2]], vcl[tet[3]]);
+    }
+
+  }
+
+  /**
+   * Gather the corners of tetrahedra t to t + n - 1 from a VectorArray.
+   */
+  template<VectorLayout Layout>
+  static void
+  gather(const VectorArray<Layout> &vertices, const tet_list &til, size_t t, size_t n, TetQualityBatch &batch) {
+
+    for (size_t l = 0; l < WIDTH; ++l) {
+      const auto &tet = til[t + (l < n ? l : 0)];
+      for (size_t k = 0; k < 4; ++k) {
+        batch.x[k][l] = vertices(tet[k], 0);
+        batch.y[k][l] = vertices(tet[k], 1);
+        batch.z[k][l] = vertices(tet[k], 2);
+      }
+    }
+
+  }
+
+  /**
+   * Convert the largest cosine between two faces' normals to the smallest
+   * dihedral angle, in degrees.
+   */
+  static double
+  dihedral_degrees(double max_cos) {
+
+    constexpr double pi = 3.14159265358979323846;
+
+    return std::acos(std::clamp(max_cos, -1.0, 1.0)) * 180.0 / pi;
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_MESH_QUALITY_HPP_
@@ -0,0 +1,149 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_MESH_REGISTRY_HPP_
+#define MFC_INCLUDE_MESH_REGISTRY_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "flat_hash_map.hpp"
+#include "mesh.hpp"
+#include "mesh_hash.hpp"
+
+/**
+ * A registry of the distinct meshes that have been loaded, keyed by content
+ * hash. Loaders given a registry hand back the registered copy of a mesh they
+ * have seen before, so models loaded from many files that share a mesh share
+ * one copy of it. The registry only holds weak references: a mesh is freed
+ * once the last model using it is gone. It is safe to use from several
+ * threads.
+ */
+class MeshRegistry {
+
+ public:
+
+  /**
+   * Retrieve the registered copy of a mesh, registering it if it is new.
+   * @param mesh the mesh.
+   * @return the shared mesh.
+   */
+  std::shared_ptr<const Mesh>
+  intern(Mesh mesh) {
+
+    uint64_t hash = mesh_hash(mesh);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto &entries = _meshes[hash];
+    std::erase_if(entries, [](const auto &entry) { return entry.expired(); });
+
+    // Compare the contents too, in case of a collision.
+    for (const auto &entry : entries) {
+      if (auto shared = entry.lock(); shared && same(*shared, mesh)) {
+        _n_hits++;
+        return shared;
+      }
+    }
+
+    auto shared = std::make_shared<const Mesh>(std::move(mesh));
+    entries.push_back(shared);
+
+    return shared;
+
+  }
+
+  /**
+   * Retrieve a registered mesh by content hash, e.g. one read from a file's
+   * `hash' attribute, so that a loader can skip reading a mesh it has
+   * already got. The contents are not compared, a 64-bit hash is trusted.
+   * @param hash the mesh's content hash (see `mesh_hash').
+   * @return the shared mesh, or null if none is registered.
+   */
+  std::shared_ptr<const Mesh>
+  find(uint64_t hash) {
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto *entries = _meshes.find(hash);
+    if (entries == nullptr) return nullptr;
+
+    for (const auto &entry : *entries) {
+      if (auto shared = entry.lock()) {
+        _n_hits++;
+        return shared;
+      }
+    }
+
+    return nullptr;
+
+  }
+
+  /**
+   * Retrieve the number of distinct meshes that are still in use.
+   */
+  [[nodiscard]] size_t
+  size() const {
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    size_t n = 0;
+    _meshes.for_each([&n](uint64_t, const auto &entries) {
+      for (const auto &entry : entries) n += entry.expired() ? 0 : 1;
+    });
+
+    return n;
+
+  }
+
+  /**
+   * Retrieve the number of meshes that were found in the registry.
+   */
+  [[nodiscard]] size_t
+  n_hits() const {
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _n_hits;
+
+  }
+
+  /**
+   * Share a mesh through a registry, if one is given.
+   * @param mesh the mesh.
+   * @param registry the registry (may be null).
+   * @return the shared mesh.
+   */
+  static std::shared_ptr<const Mesh>
+  share(Mesh mesh, MeshRegistry *registry) {
+
+    if (registry) return registry->intern(std::move(mesh));
+
+    return std::make_shared<const Mesh>(std::move(mesh));
+
+  }
+
+ private:
+
+  mutable std::mutex _mutex;
+
+  // The registered meshes, by content hash (more than one on a collision).
+  FlatHashMap<uint64_t, std::vector<std::weak_ptr<const Mesh>>> _meshes;
+
+  size_t _n_hits = 0;
+
+  static bool
+  same(const Mesh &a, const Mesh &b) {
+
+    return a.vcl() == b.vcl() && a.til() == b.til() && a.sml() == b.sml()
+        && a.vertex_ids() == b.vertex_ids() && a.element_ids() == b.element_ids();
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_MESH_REGISTRY_HPP_
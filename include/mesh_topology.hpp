@@ -0,0 +1,387 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_MESH_TOPOLOGY_HPP_
+#define MFC_INCLUDE_MESH_TOPOLOGY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "aliases.hpp"
+#include "mesh.hpp"
+#include "parallel.hpp"
+#include "radix_sort.hpp"
+
+/**
+ * Object that will be thrown on mesh topology exception.
+ */
+class MeshTopologyException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  MeshTopologyException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * A compressed sparse row (CSR) adjacency list: row i is the range
+ * values[offsets[i]] ... values[offsets[i + 1] - 1].
+ */
+struct CompressedRows {
+
+  std::vector<size_t> offsets{0};
+
+  std::vector<size_t> values;
+
+  /**
+   * Retrieve the number of rows.
+   */
+  [[nodiscard]] size_t
+  size() const { return offsets.size() - 1; }
+
+  /**
+   * Retrieve a row.
+   * @param i the index of the row.
+   * @return the values in the row.
+   */
+  [[nodiscard]] std::span<const size_t>
+  row(size_t i) const {
+    return {values.data() + offsets[i], offsets[i + 1] - offsets[i]};
+  }
+
+};
+
+/**
+ * The adjacency information of a tetrahedral mesh, built by sorting face and
+ * edge keys with a parallel radix sort rather than hashing them. All of the
+ * adjacency lists are stored as flat arrays.
+ *
+ * Local face f of a tetrahedron is the face opposite its vertex f. Local edges
+ * are numbered (0,1), (0,2), (0,3), (1,2), (1,3), (2,3).
+ */
+class MeshTopology {
+
+ public:
+
+  // Marks a boundary face in `tet_neighbours'.
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  // The local vertices of each local edge.
+  static constexpr std::array<std::array<size_t, 2>, 6> LOCAL_EDGES{{
+      {0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}
+  }};
+
+  /**
+   * Build the topology of a mesh.
+   * @param mesh the mesh.
+   */
+  explicit MeshTopology(const Mesh &mesh) {
+
+    const auto &til = mesh.til();
+
+    if (mesh.vcl().size() >= (uint64_t{1} << 32)) {
+      throw MeshTopologyException("Too many vertices (must be < 2^32).");
+    }
+    if (4 * til.size() >= (uint64_t{1} << 32)) {
+      throw MeshTopologyException("Too many tetrahedra (must be < 2^30).");
+    }
+
+    _n_verts = mesh.vcl().size();
+    _vertex_bits = std::max(1u, significant_bits(_n_verts));
+
+    build_faces(til);
+    build_edges(til);
+    build_vertex_vertices();
+
+  }
+
+  /**
+   * Retrieve the unique faces, each with its vertex indices sorted.
+   */
+  [[nodiscard]] const tri_list &
+  faces() const { return _faces; }
+
+  /**
+   * Retrieve the face index of each local face of each tetrahedron.
+   */
+  [[nodiscard]] const std::vector<std::array<size_t, 4>> &
+  tet_faces() const { return _tet_faces; }
+
+  /**
+   * Retrieve the neighbour across each local face of each tetrahedron, `npos'
+   * for boundary faces (and for faces shared by more than two tetrahedra).
+   */
+  [[nodiscard]] const std::vector<std::array<size_t, 4>> &
+  tet_neighbours() const { return _tet_neighbours; }
+
+  /**
+   * Retrieve the tetrahedra that share each face.
+   */
+  [[nodiscard]] const CompressedRows &
+  face_tets() const { return _face_tets; }
+
+  /**
+   * Retrieve the unique edges, each with its vertex indices sorted.
+   */
+  [[nodiscard]] const edge_list &
+  edges() const { return _edges; }
+
+  /**
+   * Retrieve the tetrahedra that share each edge.
+   */
+  [[nodiscard]] const CompressedRows &
+  edge_tets() const { return _edge_tets; }
+
+  /**
+   * Retrieve the (sorted) vertices connected to each vertex by an edge.
+   */
+  [[nodiscard]] const CompressedRows &
+  vertex_vertices() const { return _vertex_vertices; }
+
+ private:
+
+  size_t _n_verts = 0;
+
+  unsigned _vertex_bits = 1;
+
+  tri_list _faces;
+
+  std::vector<std::array<size_t, 4>> _tet_faces;
+
+  std::vector<std::array<size_t, 4>> _tet_neighbours;
+
+  CompressedRows _face_tets;
+
+  edge_list _edges;
+
+  CompressedRows _edge_tets;
+
+  CompressedRows _vertex_vertices;
+
+  /**
+   * A sort record: `key' holds the two lowest vertex indices (high and low 32
+   * bits), `aux' holds the third vertex index (faces only) in its high 32 bits
+   * and the owner in its low 32 bits.
+   */
+  struct Record {
+    uint64_t key;
+    uint64_t aux;
+  };
+
+  /**
+   * Find the runs of records with equal keys in a sorted list.
+   * @param records the sorted records.
+   * @param same a predicate that is true if two records have the same key.
+   * @return the start of each run, followed by the number of records.
+   */
+  template<typename Same>
+  static std::vector<size_t>
+  run_offsets(const std::vector<Record> &records, Same same) {
+
+    size_t n = records.size();
+    size_t n_threads = std::min(n_worker_threads(), std::max<size_t>(1, n / 65536));
+
+    auto block_begin = [&](size_t t) { return t * n / n_threads; };
+    auto is_head = [&](size_t i) { return i == 0 || !same(records[i - 1], records[i]); };
+
+    // Count the runs starting in each block.
+    std::vector<size_t> block_runs(n_threads + 1, 0);
+    parallel_for(n_threads, [&](size_t t_begin, size_t t_end) {
+      for (size_t t = t_begin; t < t_end; ++t) {
+        for (size_t i = block_begin(t); i < block_begin(t + 1); ++i) {
+          if (is_head(i)) block_runs[t + 1]++;
+        }
+      }
+    }, n_threads);
+    for (size_t t = 1; t <= n_threads; ++t) block_runs[t] += block_runs[t - 1];
+
+    std::vector<size_t> offsets(block_runs.back() + 1);
+    offsets.back() = n;
+
+    parallel_for(n_threads, [&](size_t t_begin, size_t t_end) {
+      for (size_t t = t_begin; t < t_end; ++t) {
+        size_t r = block_runs[t];
+        for (size_t i = block_begin(t); i < block_begin(t + 1); ++i) {
+          if (is_head(i)) offsets[r++] = i;
+        }
+      }
+    }, n_threads);
+
+    return offsets;
+
+  }
+
+  /**
+   * Build the faces, tet to face, face to tets and tet to tets adjacency.
+   * @param til the tetrahedra.
+   */
+  void
+  build_faces(const tet_list &til) {
+
+    size_t n_tets = til.size();
+
+    std::vector<Record> records(4 * n_tets);
+    parallel_for(n_tets, [&](size_t begin, size_t end) {
+      for (size_t t = begin; t < end; ++t) {
+        for (size_t f = 0; f < 4; ++f) {
+          std::array<uint64_t, 3> v{};
+          for (size_t i = 0, j = 0; i < 4; ++i) {
+            if (i != f) v[j++] = til[t][i];
+          }
+          std::sort(v.begin(), v.end());
+          records[4 * t + f] = {(v[0] << 32) | v[1], (v[2] << 32) | (4 * t + f)};
+        }
+      }
+    });
+
+    // Sort by the third, second then first vertex.
+    radix_sort(records, [](const Record &r) { return r.aux; }, 32, 32 + _vertex_bits);
+    radix_sort(records, [](const Record &r) { return r.key; }, 0, _vertex_bits);
+    radix_sort(records, [](const Record &r) { return r.key; }, 32, 32 + _vertex_bits);
+
+    _face_tets.offsets = run_offsets(records, [](const Record &a, const Record &b) {
+      return a.key == b.key && (a.aux >> 32) == (b.aux >> 32);
+    });
+    _face_tets.values.resize(records.size());
+
+    size_t n_faces = _face_tets.size();
+    _faces.resize(n_faces);
+    _tet_faces.resize(n_tets);
+    _tet_neighbours.assign(n_tets, {npos, npos, npos, npos});
+
+    parallel_for(n_faces, [&](size_t begin, size_t end) {
+      for (size_t face = begin; face < end; ++face) {
+
+        size_t first = _face_tets.offsets[face];
+        size_t last = _face_tets.offsets[face + 1];
+
+        const Record &r = records[first];
+        _faces[face] = {r.key >> 32, r.key & 0xffffffff, r.aux >> 32};
+
+        for (size_t i = first; i < last; ++i) {
+          size_t owner = records[i].aux & 0xffffffff;
+          _face_tets.values[i] = owner / 4;
+          _tet_faces[owner / 4][owner % 4] = face;
+        }
+
+        if (last - first == 2) {
+          size_t owner0 = records[first].aux & 0xffffffff;
+          size_t owner1 = records[first + 1].aux & 0xffffffff;
+          _tet_neighbours[owner0 / 4][owner0 % 4] = owner1 / 4;
+          _tet_neighbours[owner1 / 4][owner1 % 4] = owner0 / 4;
+        }
+
+      }
+    });
+
+  }
+
+  /**
+   * Build the edges and edge to tets adjacency.
+   * @param til the tetrahedra.
+   */
+  void
+  build_edges(const tet_list &til) {
+
+    size_t n_tets = til.size();
+
+    std::vector<Record> records(6 * n_tets);
+    parallel_for(n_tets, [&](size_t begin, size_t end) {
+      for (size_t t = begin; t < end; ++t) {
+        for (size_t e = 0; e < 6; ++e) {
+          uint64_t a = til[t][LOCAL_EDGES[e][0]];
+          uint64_t b = til[t][LOCAL_EDGES[e][1]];
+          if (a > b) std::swap(a, b);
+          records[6 * t + e] = {(a << 32) | b, t};
+        }
+      }
+    });
+
+    radix_sort(records, [](const Record &r) { return r.key; }, 0, _vertex_bits);
+    radix_sort(records, [](const Record &r) { return r.key; }, 32, 32 + _vertex_bits);
+
+    _edge_tets.offsets = run_offsets(records, [](const Record &a, const Record &b) {
+      return a.key == b.key;
+    });
+    _edge_tets.values.resize(records.size());
+
+    size_t n_edges = _edge_tets.size();
+    _edges.resize(n_edges);
+
+    parallel_for(n_edges, [&](size_t begin, size_t end) {
+      for (size_t edge = begin; edge < end; ++edge) {
+        size_t first = _edge_tets.offsets[edge];
+        size_t last = _edge_tets.offsets[edge + 1];
+        _edges[edge] = {records[first].key >> 32, records[first].key & 0xffffffff};
+        for (size_t i = first; i < last; ++i) {
+          _edge_tets.values[i] = records[i].aux;
+        }
+      }
+    });
+
+  }
+
+  /**
+   * Build the vertex to vertices adjacency from the (sorted) unique edges.
+   * For a vertex v the neighbours u < v come from edges (u, v) and appear in
+   * increasing order of u, they are followed by the neighbours w > v from
+   * edges (v, w), so each row is sorted without a further sort.
+   */
+  void
+  build_vertex_vertices() {
+
+    std::vector<size_t> n_lower(_n_verts, 0);
+    std::vector<size_t> degree(_n_verts, 0);
+    for (const auto &e : _edges) {
+      n_lower[e[1]]++;
+      degree[e[0]]++;
+      degree[e[1]]++;
+    }
+
+    _vertex_vertices.offsets.assign(_n_verts + 1, 0);
+    for (size_t v = 0; v < _n_verts; ++v) {
+      _vertex_vertices.offsets[v + 1] = _vertex_vertices.offsets[v] + degree[v];
+    }
+    _vertex_vertices.values.resize(_vertex_vertices.offsets.back());
+
+    std::vector<size_t> lower_cursor(_vertex_vertices.offsets.begin(),
+                                     _vertex_vertices.offsets.end() - 1);
+    std::vector<size_t> upper_cursor(_n_verts);
+    for (size_t v = 0; v < _n_verts; ++v) {
+      upper_cursor[v] = lower_cursor[v] + n_lower[v];
+    }
+
+    for (const auto &e : _edges) {
+      _vertex_vertices.values[lower_cursor[e[1]]++] = e[0];
+      _vertex_vertices.values[upper_cursor[e[0]]++] = e[1];
+    }
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_MESH_TOPOLOGY_HPP_
@@ -0,0 +1,447 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_MESH_VALIDATOR_HPP_
+#define MFC_INCLUDE_MESH_VALIDATOR_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "aliases.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "parallel.hpp"
+
+class MeshValidatorException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  MeshValidatorException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * The result of validating a mesh. Each list holds the offending tetrahedra
+ * (or faces, or vertices) in increasing order.
+ */
+struct ValidationReport {
+
+  size_t n_vertices = 0;
+  size_t n_tets = 0;
+
+  // Tetrahedra with a vertex index that is not a vertex of the mesh.
+  teti_list out_of_range;
+
+  // Tetrahedra that use the same vertex more than once.
+  teti_list repeated_vertex;
+
+  // Tetrahedra with a negative signed volume.
+  teti_list inverted;
+
+  // Tetrahedra (with four distinct vertices) with zero volume.
+  teti_list degenerate;
+
+  // Pairs of tetrahedra with the same four vertices, (first, duplicate).
+  std::vector<std::array<size_t, 2>> duplicates;
+
+  // Faces (sorted vertex indices) shared by more than two tetrahedra.
+  tri_list non_manifold_faces;
+
+  // Vertices not used by any tetrahedron.
+  vi_list orphan_vertices;
+
+  // False if the face checks were skipped (invalid indices, or a mesh that is
+  // too large for them).
+  bool faces_checked = false;
+
+  /**
+   * Retrieve true if nothing was found.
+   */
+  [[nodiscard]] bool
+  valid() const {
+
+    return out_of_range.empty() && repeated_vertex.empty() && inverted.empty()
+        && degenerate.empty() && duplicates.empty() && non_manifold_faces.empty()
+        && orphan_vertices.empty();
+
+  }
+
+  /**
+   * Retrieve true if every vertex index is in range, i.e. the mesh can be
+   * indexed safely by writers and downstream tools.
+   */
+  [[nodiscard]] bool
+  usable() const {
+
+    return out_of_range.empty();
+
+  }
+
+  /**
+   * Print a one line per check summary, followed by the first few offenders
+   * of each failed check.
+   * @param out the output stream.
+   * @param max_listed the number of offenders to list for each check.
+   */
+  void
+  print(std::ostream &out, size_t max_listed = 5) const {
+
+    auto line = [&](const char *name, const auto &list, auto &&show) {
+      out << "  " << name << ": " << list.size();
+      for (size_t i = 0; i < std::min(max_listed, list.size()); ++i) {
+        out << (i == 0 ? " (" : ", ");
+        show(list[i]);
+      }
+      if (!list.empty()) out << (list.size() > max_listed ? ", ...)" : ")");
+      out << std::endl;
+    };
+    auto index = [&](size_t i) { out << i; };
+    auto tuple = [&](const auto &a) {
+      out << "[";
+      for (size_t i = 0; i < a.size(); ++i) out << (i == 0 ? "" : " ") << a[i];
+      out << "]";
+    };
+
+    out << "Mesh validation: " << n_vertices << " vertices, " << n_tets << " tets, "
+        << (valid() ? "valid" : "INVALID") << std::endl;
+    line("out of range indices", out_of_range, index);
+    line("repeated vertices", repeated_vertex, index);
+    line("inverted", inverted, index);
+    line("degenerate", degenerate, index);
+    if (faces_checked) {
+      line("duplicates", duplicates, tuple);
+      line("non-manifold faces", non_manifold_faces, tuple);
+    } else {
+      out << "  duplicates & non-manifold faces: not checked" << std::endl;
+    }
+    line("orphan vertices", orphan_vertices, index);
+
+  }
+
+  /**
+   * Write the full report as a JSON object.
+   * @param out the output stream.
+   */
+  void
+  write_json(std::ostream &out) const {
+
+    auto list = [&](const char *name, const auto &values, bool last = false) {
+      out << "  \"" << name << "\": [";
+      for (size_t i = 0; i < values.size(); ++i) {
+        out << (i == 0 ? "" : ", ");
+        write_json_value(out, values[i]);
+      }
+      out << "]" << (last ? "" : ",") << "\n";
+    };
+
+    out << "{\n";
+    out << "  \"n_vertices\": " << n_vertices << ",\n";
+    out << "  \"n_tets\": " << n_tets << ",\n";
+    out << "  \"valid\": " << (valid() ? "true" : "false") << ",\n";
+    out << "  \"faces_checked\": " << (faces_checked ? "true" : "false") << ",\n";
+    list("out_of_range", out_of_range);
+    list("repeated_vertex", repeated_vertex);
+    list("inverted", inverted);
+    list("degenerate", degenerate);
+    list("duplicates", duplicates);
+    list("non_manifold_faces", non_manifold_faces);
+    list("orphan_vertices", orphan_vertices, true);
+    out << "}\n";
+
+  }
+
+ private:
+
+  static void
+  write_json_value(std::ostream &out, size_t value) { out << value; }
+
+  template<size_t N>
+  static void
+  write_json_value(std::ostream &out, const std::array<size_t, N> &value) {
+
+    out << "[";
+    for (size_t i = 0; i < N; ++i) out << (i == 0 ? "" : ", ") << value[i];
+    out << "]";
+
+  }
+
+};
+
+/**
+ * Checks the connectivity of a mesh: vertex indices in range, distinct
+ * vertices per tetrahedron, orientation, duplicate tetrahedra, faces shared by
+ * more than two tetrahedra and unused vertices. The per-tetrahedron checks
+ * are one streaming pass over the tetrahedra; the face checks bucket the four
+ * faces of each tetrahedron by their lowest vertex, so the whole thing is a
+ * few passes over memory and cheap enough to run on every conversion.
+ */
+class MeshValidator {
+
+ public:
+
+  /**
+   * Validate a mesh.
+   * @param mesh the mesh.
+   * @return the report.
+   */
+  static ValidationReport
+  validate(const Mesh &mesh) {
+
+    const auto &vcl = mesh.vcl();
+    const auto &til = mesh.til();
+
+    size_t n_verts = vcl.size();
+    size_t n_tets = til.size();
+
+    ValidationReport report;
+    report.n_vertices = n_verts;
+    report.n_tets = n_tets;
+
+    // Per-tetrahedron checks, and mark the used vertices.
+    std::vector<uint8_t> used(n_verts, 0);
+    std::mutex report_mutex;
+
+    parallel_for(n_tets, [&](size_t begin, size_t end) {
+
+      teti_list out_of_range, repeated_vertex, inverted, degenerate;
+
+      for (size_t t = begin; t < end; ++t) {
+
+        const tet &v = til[t];
+
+        if (v[0] >= n_verts || v[1] >= n_verts || v[2] >= n_verts || v[3] >= n_verts) {
+          out_of_range.push_back(t);
+          continue;
+        }
+
+        for (size_t i = 0; i < 4; ++i) {
+          std::atomic_ref<uint8_t>(used[v[i]]).store(1, std::memory_order_relaxed);
+        }
+
+        if (v[0] == v[1] || v[0] == v[2] || v[0] == v[3]
+            || v[1] == v[2] || v[1] == v[3] || v[2] == v[3]) {
+          repeated_vertex.push_back(t);
+          continue;
+        }
+
+        double volume6 = tet_signed_volume6(vcl[v[0]], vcl[v[1]], vcl[v[2]], vcl[v[3]]);
+        if (volume6 < 0.0) {
+          inverted.push_back(t);
+        } else if (volume6 == 0.0) {
+          degenerate.push_back(t);
+        }
+
+      }
+
+      std::lock_guard<std::mutex> lock(report_mutex);
+      append(report.out_of_range, out_of_range);
+      append(report.repeated_vertex, repeated_vertex);
+      append(report.inverted, inverted);
+      append(report.degenerate, degenerate);
+
+    });
+
+    std::sort(report.out_of_range.begin(), report.out_of_range.end());
+    std::sort(report.repeated_vertex.begin(), report.repeated_vertex.end());
+    std::sort(report.inverted.begin(), report.inverted.end());
+    std::sort(report.degenerate.begin(), report.degenerate.end());
+
+    for (size_t v = 0; v < n_verts; ++v) {
+      if (!used[v]) report.orphan_vertices.push_back(v);
+    }
+
+    // The face checks need valid indices that fit in 32 bits.
+    if (report.out_of_range.empty() && n_verts < (uint64_t{1} << 32)) {
+      check_faces(til, n_verts, report);
+      report.faces_checked = true;
+    }
+
+    return report;
+
+  }
+
+  /**
+   * Create a copy of a mesh with its inverted tetrahedra re-oriented (by
+   * swapping their last two vertices).
+   * @param mesh the mesh.
+   * @param report the mesh's validation report.
+   * @return the repaired mesh.
+   */
+  static Mesh
+  reorient(const Mesh &mesh, const ValidationReport &report) {
+
+    if (report.n_tets != mesh.til().size()) {
+      throw MeshValidatorException("Validation report does not match the mesh.");
+    }
+
+    tet_list til = mesh.til();
+    for (auto t : report.inverted) std::swap(til[t][2], til[t][3]);
+
+    return {mesh.vcl(), std::move(til), mesh.sml(), mesh.vertex_ids(), mesh.element_ids()};
+
+  }
+
+ private:
+
+  /**
+   * A face record, kept in the bucket of the face's lowest vertex: `key'
+   * holds the other two vertex indices (high and low 32 bits), `owner' is
+   * 4 * tet + local face.
+   */
+  struct Record {
+    uint64_t key;
+    uint64_t owner;
+  };
+
+  template<typename T>
+  static void
+  append(std::vector<T> &to, const std::vector<T> &from) {
+
+    to.insert(to.end(), from.begin(), from.end());
+
+  }
+
+  /**
+   * Group the faces of every tetrahedron and look for duplicate tetrahedra
+   * (two owners of a face with the same opposite vertex) and non-manifold
+   * faces (more than two distinct opposite vertices). Faces are bucketed by
+   * their lowest vertex with a counting sort, then each (small) bucket is
+   * sorted on its own, which touches memory far less than a full radix sort.
+   * @param til the tetrahedra.
+   * @param n_verts the number of vertices.
+   * @param report the report to add to.
+   */
+  static void
+  check_faces(const tet_list &til, size_t n_verts, ValidationReport &report) {
+
+    size_t n_tets = til.size();
+
+    // The sorted vertices of local face f of tetrahedron t.
+    auto face = [&](size_t t, size_t f) {
+      std::array<uint64_t, 3> v{};
+      for (size_t i = 0, j = 0; i < 4; ++i) {
+        if (i != f) v[j++] = til[t][i];
+      }
+      if (v[0] > v[1]) std::swap(v[0], v[1]);
+      if (v[1] > v[2]) std::swap(v[1], v[2]);
+      if (v[0] > v[1]) std::swap(v[0], v[1]);
+      return v;
+    };
+
+    // Bucket offsets: count the faces per lowest vertex, then a prefix sum.
+    std::vector<uint64_t> offsets(n_verts + 1, 0);
+    parallel_for(n_tets, [&](size_t begin, size_t end) {
+      for (size_t t = begin; t < end; ++t) {
+        for (size_t f = 0; f < 4; ++f) {
+          std::atomic_ref<uint64_t>(offsets[face(t, f)[0] + 1]).fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+    for (size_t v = 0; v < n_verts; ++v) offsets[v + 1] += offsets[v];
+
+    std::vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+    std::vector<Record> records(4 * n_tets);
+    parallel_for(n_tets, [&](size_t begin, size_t end) {
+      for (size_t t = begin; t < end; ++t) {
+        for (size_t f = 0; f < 4; ++f) {
+          auto v = face(t, f);
+          uint64_t i = std::atomic_ref<uint64_t>(cursor[v[0]]).fetch_add(1, std::memory_order_relaxed);
+          records[i] = {(v[1] << 32) | v[2], 4 * t + f};
+        }
+      }
+    });
+
+    auto opposite = [&](const Record &r) { return til[r.owner / 4][r.owner % 4]; };
+
+    std::mutex report_mutex;
+
+    parallel_for(n_verts, [&](size_t begin, size_t end) {
+
+      std::vector<std::array<size_t, 2>> duplicates;
+      tri_list non_manifold_faces;
+      std::vector<size_t> opposites;
+
+      for (size_t v = begin; v < end; ++v) {
+
+        auto first_record = records.begin() + offsets[v];
+        auto last_record = records.begin() + offsets[v + 1];
+        std::sort(first_record, last_record, [](const Record &a, const Record &b) {
+          return a.key < b.key || (a.key == b.key && a.owner < b.owner);
+        });
+
+        for (auto first = first_record; first != last_record;) {
+
+          auto last = first + 1;
+          while (last != last_record && last->key == first->key) ++last;
+
+          if (last - first > 1) {
+
+            uint64_t highest = first->key & 0xffffffff;
+
+            // A pair of duplicates shares all four faces, report it once: for
+            // the face opposite the pair's highest vertex.
+            for (auto i = first; i != last; ++i) {
+              for (auto j = i + 1; j != last; ++j) {
+                if (opposite(*i) == opposite(*j) && opposite(*i) > highest) {
+                  duplicates.push_back({i->owner / 4, j->owner / 4});
+                }
+              }
+            }
+
+            if (last - first > 2) {
+              opposites.clear();
+              for (auto i = first; i != last; ++i) opposites.push_back(opposite(*i));
+              std::sort(opposites.begin(), opposites.end());
+              if (std::unique(opposites.begin(), opposites.end()) - opposites.begin() > 2) {
+                non_manifold_faces.push_back({v, first->key >> 32, highest});
+              }
+            }
+
+          }
+
+          first = last;
+
+        }
+
+      }
+
+      std::lock_guard<std::mutex> lock(report_mutex);
+      append(report.duplicates, duplicates);
+      append(report.non_manifold_faces, non_manifold_faces);
+
+    });
+
+    std::sort(report.duplicates.begin(), report.duplicates.end());
+    std::sort(report.non_manifold_faces.begin(), report.non_manifold_faces.end());
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_MESH_VALIDATOR_HPP_
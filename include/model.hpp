@@ -5,6 +5,7 @@
 #ifndef MFC_INCLUDE_MODEL_HPP_
 #define MFC_INCLUDE_MODEL_HPP_
 
+#include <memory>
 #include <utility>
 
 #include "aliases.hpp"
@@ -12,7 +13,9 @@
 #include "mesh.hpp"
 
 /**
- * A model consists of a mesh and a field.
+ * A model consists of a mesh and a field. The mesh is immutable and shared,
+ * so that models with the same mesh (e.g. loaded through a MeshRegistry)
+ * hold a single copy of it.
  */
 class Model {
 
@@ -21,17 +24,30 @@ class Model {
   Model(v_list vcl,
         tet_list til,
         sm_list sml) :
-      _mesh{std::move(vcl), std::move(til), std::move(sml)} {}
+      _mesh{std::make_shared<const Mesh>(std::move(vcl), std::move(til), std::move(sml))} {}
 
   Model(v_list vcl,
         tet_list til,
         sm_list sml,
         FieldList field_list) :
-      _mesh{std::move(vcl), std::move(til), std::move(sml)},
+      _mesh{std::make_shared<const Mesh>(std::move(vcl), std::move(til), std::move(sml))},
+      _field_list{std::move(field_list)} {}
+
+  Model(Mesh mesh,
+        FieldList field_list) :
+      _mesh{std::make_shared<const Mesh>(std::move(mesh))},
+      _field_list{std::move(field_list)} {}
+
+  Model(std::shared_ptr<const Mesh> mesh,
+        FieldList field_list) :
+      _mesh{std::move(mesh)},
       _field_list{std::move(field_list)} {}
 
   [[nodiscard]] const Mesh &
-  mesh() const { return _mesh; }
+  mesh() const { return *_mesh; }
+
+  [[nodiscard]] const std::shared_ptr<const Mesh> &
+  shared_mesh() const { return _mesh; }
 
   [[nodiscard]] const FieldList &
   field_list() const { return _field_list; }
@@ -40,7 +56,7 @@ class Model {
 
  private:
 
-  Mesh _mesh;
+  std::shared_ptr<const Mesh> _mesh;
 
   FieldList _field_list;
 
@@ -0,0 +1,128 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_MODEL_BUFFERS_HPP_
+#define MFC_INCLUDE_MODEL_BUFFERS_HPP_
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/**
+ * A non-owning view of a caller's buffer as a table of `rows' x `columns'
+ * values, with consecutive rows `stride' values apart (stride >= columns),
+ * so that padded layouts such as float4 vertex arrays can be filled in
+ * place.
+ */
+template<typename T>
+class StridedSpan {
+
+ public:
+
+  /**
+   * Create an empty view.
+   */
+  StridedSpan() = default;
+
+  /**
+   * Create a view of a padded buffer.
+   * @param data the first value.
+   * @param rows the number of rows.
+   * @param columns the number of values per row.
+   * @param stride the distance in values between consecutive rows.
+   */
+  StridedSpan(T *data, size_t rows, size_t columns, size_t stride) :
+      _data(data), _rows(rows), _columns(columns), _stride(stride) {}
+
+  /**
+   * Create a view of a packed buffer.
+   * @param data the buffer, rows x columns values.
+   * @param columns the number of values per row.
+   */
+  StridedSpan(std::span<T> data, size_t columns) :
+      _data(data.data()), _rows(data.size() / columns), _columns(columns), _stride(columns) {}
+
+  [[nodiscard]] T *
+  data() const { return _data; }
+
+  [[nodiscard]] size_t
+  rows() const { return _rows; }
+
+  [[nodiscard]] size_t
+  columns() const { return _columns; }
+
+  [[nodiscard]] size_t
+  stride() const { return _stride; }
+
+  [[nodiscard]] bool
+  empty() const { return _data == nullptr; }
+
+  T &
+  operator()(size_t row, size_t column) const { return _data[row * _stride + column]; }
+
+ private:
+
+  T *_data = nullptr;
+
+  size_t _rows = 0;
+
+  size_t _columns = 0;
+
+  size_t _stride = 0;
+
+};
+
+/**
+ * The sizes of the arrays of a stored model, for callers to allocate the
+ * buffers that a loader fills.
+ */
+struct ModelShape {
+
+  // Number of vertices.
+  size_t n_vertices = 0;
+
+  // Number of tetrahedra.
+  size_t n_elements = 0;
+
+  // Number of fields.
+  size_t n_fields = 0;
+
+  // True if the model holds the original vertex indices of a reordered mesh.
+  bool has_vertex_ids = false;
+
+  // True if the model holds the original element indices of a reordered mesh.
+  bool has_element_ids = false;
+
+};
+
+/**
+ * Caller owned buffers for a loader to read a model in to directly, instead
+ * of in to a Model's own vectors. Real and Index are the caller's value types
+ * (e.g. float and uint32_t); values are converted while being read. Empty
+ * views are skipped, so a caller only pays for the arrays that it needs.
+ */
+template<typename Real, typename Index>
+struct ModelBuffers {
+
+  // n_vertices x 3 vertex coordinates.
+  StridedSpan<Real> vertices;
+
+  // n_elements x 4 vertex indices.
+  StridedSpan<Index> elements;
+
+  // n_elements submesh ids.
+  std::span<Index> submesh;
+
+  // n_vertices original vertex indices (reordered meshes only).
+  std::span<Index> vertex_ids;
+
+  // n_elements original element indices (reordered meshes only).
+  std::span<Index> element_ids;
+
+  // n_vertices x 3 vectors, for each of the first fields.size() fields.
+  std::vector<StridedSpan<Real>> fields;
+
+};
+
+#endif //MFC_INCLUDE_MODEL_BUFFERS_HPP_
@@ -0,0 +1,84 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_PARALLEL_HPP_
+#define MFC_INCLUDE_PARALLEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Retrieve the number of worker threads to use for parallel loops.
+ * @return the number of hardware threads (at least one).
+ */
+inline size_t
+n_worker_threads() {
+
+  size_t n = std::thread::hardware_concurrency();
+
+  return n == 0 ? 1 : n;
+
+}
+
+/**
+ * Split the range [0, n) in to contiguous blocks and call `fn(begin, end)` on
+ * each block from a separate thread. The first exception thrown by any of the
+ * workers is re-thrown on the calling thread once all workers have finished.
+ * @param n the size of the range.
+ * @param fn the function that processes a block [begin, end).
+ * @param n_threads the number of threads to use (0 selects the number of
+ *                  hardware threads).
+ */
+template<typename Fn>
+void
+parallel_for(size_t n, Fn &&fn, size_t n_threads = 0) {
+
+  if (n == 0) return;
+
+  if (n_threads == 0) n_threads = n_worker_threads();
+  n_threads = std::min(n_threads, n);
+
+  if (n_threads == 1) {
+    fn(size_t{0}, n);
+    return;
+  }
+
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  std::vector<std::thread> workers;
+  workers.reserve(n_threads);
+
+  size_t block_size = n / n_threads;
+  size_t remainder = n % n_threads;
+  size_t begin = 0;
+
+  for (size_t t = 0; t < n_threads; ++t) {
+
+    size_t end = begin + block_size + (t < remainder ? 1 : 0);
+
+    workers.emplace_back([&fn, &error, &error_mutex, begin, end]() {
+      try {
+        fn(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::current_exception();
+      }
+    });
+
+    begin = end;
+
+  }
+
+  for (auto &worker : workers) worker.join();
+
+  if (error) std::rethrow_exception(error);
+
+}
+
+#endif //MFC_INCLUDE_PARALLEL_HPP_
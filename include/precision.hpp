@@ -0,0 +1,89 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_PRECISION_HPP_
+#define MFC_INCLUDE_PRECISION_HPP_
+
+#include <exception>
+#include <string>
+#include <utility>
+
+#include <H5Cpp.h>
+
+class PrecisionException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  PrecisionException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * The floating point precision that coordinates and fields are stored with
+ * in output files. Models are always held as doubles in memory, HDF5
+ * converts while writing (and back while reading): single precision halves
+ * the size of the files and the I/O, not the memory of a loaded model.
+ */
+enum class Precision {
+  SINGLE,  // 32-bit floats, enough for the ~7 significant digits of MERRILL output
+  DOUBLE   // 64-bit floats
+};
+
+/**
+ * Retrieve the precision with a given name.
+ * @param name `single', `float', `4', `double' or `8'.
+ * @return the precision.
+ */
+inline Precision
+precision(const std::string &name) {
+
+  if (name == "single" || name == "float" || name == "4") return Precision::SINGLE;
+  if (name == "double" || name == "8") return Precision::DOUBLE;
+
+  throw PrecisionException("Unknown precision '" + name + "' (single or double).");
+
+}
+
+/**
+ * Retrieve the size in bytes of a precision's floats.
+ * @param precision the precision.
+ * @return 4 or 8.
+ */
+inline size_t
+precision_bytes(Precision precision) {
+
+  return precision == Precision::SINGLE ? 4 : 8;
+
+}
+
+/**
+ * Retrieve the HDF5 file type of a precision's floats.
+ * @param precision the precision.
+ * @return the HDF5 type.
+ */
+inline const H5::PredType &
+precision_type(Precision precision) {
+
+  return precision == Precision::SINGLE ? H5::PredType::NATIVE_FLOAT : H5::PredType::NATIVE_DOUBLE;
+
+}
+
+#endif //MFC_INCLUDE_PRECISION_HPP_
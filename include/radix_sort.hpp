@@ -0,0 +1,113 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_RADIX_SORT_HPP_
+#define MFC_INCLUDE_RADIX_SORT_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "parallel.hpp"
+
+/**
+ * Stable, parallel least significant digit radix sort of `data' by the bits
+ * [first_bit, last_bit) of `key(x)', using 8-bit digits. Each pass builds one
+ * histogram per thread over a contiguous block, and the threads then scatter
+ * their blocks to disjoint output ranges. Passes whose digit is the same for
+ * every element are skipped. Sorting by a composite key is done by calling
+ * this for the least significant part first.
+ * @param data the data to sort.
+ * @param key the function returning the 64-bit key of an element.
+ * @param first_bit the least significant bit of the key to sort on.
+ * @param last_bit one past the most significant bit of the key to sort on.
+ */
+template<typename T, typename KeyFn>
+void
+radix_sort(std::vector<T> &data,
+           KeyFn key,
+           unsigned first_bit = 0,
+           unsigned last_bit = 64) {
+
+  constexpr size_t n_buckets = 256;
+
+  size_t n = data.size();
+  if (n < 2) return;
+
+  size_t n_threads = std::min(n_worker_threads(), std::max<size_t>(1, n / 65536));
+
+  std::vector<T> tmp(n);
+  std::vector<std::array<size_t, n_buckets>> counts(n_threads);
+
+  auto block_begin = [&](size_t t) { return t * n / n_threads; };
+
+  for (unsigned shift = first_bit; shift < last_bit; shift += 8) {
+
+    // Per-thread histograms.
+    parallel_for(n_threads, [&](size_t t_begin, size_t t_end) {
+      for (size_t t = t_begin; t < t_end; ++t) {
+        auto &count = counts[t];
+        count.fill(0);
+        for (size_t i = block_begin(t); i < block_begin(t + 1); ++i) {
+          count[(key(data[i]) >> shift) & 0xff]++;
+        }
+      }
+    }, n_threads);
+
+    // Skip the pass if every element has the same digit.
+    bool trivial = false;
+    for (size_t b = 0; b < n_buckets && !trivial; ++b) {
+      size_t total = 0;
+      for (size_t t = 0; t < n_threads; ++t) total += counts[t][b];
+      trivial = total == n;
+    }
+    if (trivial) continue;
+
+    // Convert the histograms to output offsets, bucket major and thread minor
+    // so that the sort is stable.
+    size_t offset = 0;
+    for (size_t b = 0; b < n_buckets; ++b) {
+      for (size_t t = 0; t < n_threads; ++t) {
+        size_t c = counts[t][b];
+        counts[t][b] = offset;
+        offset += c;
+      }
+    }
+
+    // Scatter.
+    parallel_for(n_threads, [&](size_t t_begin, size_t t_end) {
+      for (size_t t = t_begin; t < t_end; ++t) {
+        auto &cursor = counts[t];
+        for (size_t i = block_begin(t); i < block_begin(t + 1); ++i) {
+          tmp[cursor[(key(data[i]) >> shift) & 0xff]++] = data[i];
+        }
+      }
+    }, n_threads);
+
+    data.swap(tmp);
+
+  }
+
+}
+
+/**
+ * Retrieve the number of bits needed to represent a value.
+ * @param value the value.
+ * @return the number of significant bits.
+ */
+inline unsigned
+significant_bits(uint64_t value) {
+
+  unsigned bits = 0;
+  while (value != 0) {
+    bits++;
+    value >>= 1;
+  }
+
+  return bits;
+
+}
+
+#endif //MFC_INCLUDE_RADIX_SORT_HPP_
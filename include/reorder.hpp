@@ -0,0 +1,472 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_REORDER_HPP_
+#define MFC_INCLUDE_REORDER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "aliases.hpp"
+#include "geometry.hpp"
+#include "mesh_topology.hpp"
+#include "model.hpp"
+#include "parallel.hpp"
+#include "radix_sort.hpp"
+
+class MeshReordererException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  MeshReordererException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * The vertex (and element) orderings that a mesh can be put in to.
+ */
+enum class ReorderStrategy {
+  HILBERT,  // Vertices & elements along a Hilbert curve.
+  MORTON,   // Vertices & elements along a Morton (Z-order) curve.
+  RCM       // Reverse Cuthill-McKee on the vertex graph.
+};
+
+/**
+ * Retrieve the reorder strategy with a given name: "hilbert", "morton" or
+ * "rcm".
+ * @param name the name of the strategy.
+ * @return the strategy.
+ */
+inline ReorderStrategy
+reorder_strategy(const std::string &name) {
+
+  if (name == "hilbert") return ReorderStrategy::HILBERT;
+  if (name == "morton") return ReorderStrategy::MORTON;
+  if (name == "rcm") return ReorderStrategy::RCM;
+
+  throw MeshReordererException("Unknown reorder strategy '" + name + "'.");
+
+}
+
+/**
+ * Renumbers the vertices and elements of a model so that ones which are close
+ * in space (or in the mesh graph) are close in memory. Gathers over the
+ * elements then touch far fewer cache lines and HDF5 chunks map to compact
+ * regions of space.
+ */
+class MeshReorderer {
+
+ public:
+
+  // Bits per axis of the space filling curve keys.
+  static constexpr unsigned CURVE_BITS = 21;
+
+  /**
+   * Default constructor.
+   */
+  MeshReorderer() = default;
+
+  /**
+   * Reorder a model's mesh and fields. The original index of each vertex and
+   * element is kept by the new mesh (see `Mesh::vertex_ids' and
+   * `Mesh::element_ids').
+   * @param model the model.
+   * @param strategy the ordering to use.
+   * @return the reordered model.
+   */
+  static Model
+  reorder(const Model &model, ReorderStrategy strategy) {
+
+    const Mesh &mesh = model.mesh();
+
+    vi_list vertex_order;
+    teti_list element_order;
+
+    if (strategy == ReorderStrategy::RCM) {
+
+      vertex_order = rcm_order(mesh);
+
+      // Elements follow their lowest (renumbered) vertex.
+      vi_list new_index = inverse(vertex_order);
+      std::vector<std::pair<uint64_t, size_t>> keys(mesh.til().size());
+      parallel_for(keys.size(), [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+          const tet &e = mesh.til()[t];
+          keys[t] = {
+              std::min({new_index[e[0]], new_index[e[1]], new_index[e[2]], new_index[e[3]]}),
+              t
+          };
+        }
+      });
+      radix_sort(keys, [](const auto &k) { return k.first; }, 0,
+                 significant_bits(mesh.vcl().size()));
+      element_order = seconds(keys);
+
+    } else {
+
+      BoundingBox box = bounding_box(mesh.vcl());
+
+      std::vector<std::pair<uint64_t, size_t>> keys(mesh.vcl().size());
+      parallel_for(keys.size(), [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+          keys[v] = {curve_key(mesh.vcl()[v], box, strategy), v};
+        }
+      });
+      radix_sort(keys, [](const auto &k) { return k.first; }, 0, 3 * CURVE_BITS);
+      vertex_order = seconds(keys);
+
+      // Elements by the curve key of their centroids.
+      keys.resize(mesh.til().size());
+      parallel_for(keys.size(), [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+          const tet &e = mesh.til()[t];
+          vert c = scale(0.25, add(add(mesh.vcl()[e[0]], mesh.vcl()[e[1]]),
+                                   add(mesh.vcl()[e[2]], mesh.vcl()[e[3]])));
+          keys[t] = {curve_key(c, box, strategy), t};
+        }
+      });
+      radix_sort(keys, [](const auto &k) { return k.first; }, 0, 3 * CURVE_BITS);
+      element_order = seconds(keys);
+
+    }
+
+    return apply(model, vertex_order, element_order);
+
+  }
+
+  /**
+   * Renumber a model's mesh and fields with the given orders.
+   * @param model the model.
+   * @param vertex_order the old index of each new vertex.
+   * @param element_order the old index of each new element.
+   * @return the renumbered model.
+   */
+  static Model
+  apply(const Model &model,
+        const vi_list &vertex_order,
+        const teti_list &element_order) {
+
+    const Mesh &mesh = model.mesh();
+
+    if (vertex_order.size() != mesh.vcl().size()
+        || element_order.size() != mesh.til().size()) {
+      throw MeshReordererException("Ordering does not match the mesh size.");
+    }
+
+    vi_list new_index = inverse(vertex_order);
+
+    v_list vcl = gather(mesh.vcl(), vertex_order);
+    sm_list sml = gather(mesh.sml(), element_order);
+
+    tet_list til(element_order.size());
+    parallel_for(til.size(), [&](size_t begin, size_t end) {
+      for (size_t t = begin; t < end; ++t) {
+        const tet &e = mesh.til()[element_order[t]];
+        til[t] = {new_index[e[0]], new_index[e[1]], new_index[e[2]], new_index[e[3]]};
+      }
+    });
+
+    // Compose with any earlier reordering, so that the ids stay original.
+    vi_list vertex_ids = mesh.vertex_ids().empty()
+                         ? vertex_order
+                         : gather(mesh.vertex_ids(), vertex_order);
+    teti_list element_ids = mesh.element_ids().empty()
+                            ? element_order
+                            : gather(mesh.element_ids(), element_order);
+
+    // The reordered fields go in to one contiguous block.
+    const auto &fields = model.field_list().fields();
+    std::vector<std::string> annotations;
+    for (const auto &field : fields) annotations.push_back(field.annotation());
+
+    FieldList field_list(annotations, vertex_order.size());
+    for (size_t f = 0; f < fields.size(); ++f) {
+      auto from = fields[f].vectors();
+      auto to = field_list.fields()[f].vectors();
+      parallel_for(vertex_order.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) to[i] = from[vertex_order[i]];
+      });
+    }
+
+    return {
+        Mesh(std::move(vcl),
+             std::move(til),
+             std::move(sml),
+             std::move(vertex_ids),
+             std::move(element_ids)),
+        std::move(field_list)
+    };
+
+  }
+
+  /**
+   * Compute the Hilbert curve index of a point on a 2^CURVE_BITS grid per
+   * axis (Skilling's transpose algorithm).
+   * @param x the grid coordinates of the point.
+   * @return the curve index.
+   */
+  static uint64_t
+  hilbert_key(std::array<uint32_t, 3> x) {
+
+    uint32_t m = 1u << (CURVE_BITS - 1);
+
+    // Inverse undo excess work.
+    for (uint32_t q = m; q > 1; q >>= 1) {
+      uint32_t p = q - 1;
+      for (size_t i = 0; i < 3; ++i) {
+        // Branch free form of: if (x[i] & q) invert the low bits of x[0],
+        // else exchange the low bits of x[0] and x[i].
+        uint32_t set = 0u - ((x[i] & q) != 0);
+        uint32_t t = (x[0] ^ x[i]) & p & ~set;
+        x[0] ^= (p & set) | t;
+        x[i] ^= t;
+      }
+    }
+
+    // Gray encode.
+    x[1] ^= x[0];
+    x[2] ^= x[1];
+    uint32_t t = 0;
+    for (uint32_t q = m; q > 1; q >>= 1) {
+      if (x[2] & q) t ^= q - 1;
+    }
+    for (auto &xi : x) xi ^= t;
+
+    return interleave(x);
+
+  }
+
+  /**
+   * Compute the Morton (Z-order) index of a point on a 2^CURVE_BITS grid per
+   * axis.
+   * @param x the grid coordinates of the point.
+   * @return the curve index.
+   */
+  static uint64_t
+  morton_key(const std::array<uint32_t, 3> &x) {
+
+    return interleave(x);
+
+  }
+
+  /**
+   * Retrieve the curve key of a point in a bounding box: the point is scaled
+   * on to a 2^CURVE_BITS grid per axis (clamped to the box).
+   * @param p the point.
+   * @param box the bounding box.
+   * @param strategy HILBERT or MORTON.
+   * @return the curve index.
+   */
+  static uint64_t
+  curve_key(const vert &p, const BoundingBox &box, ReorderStrategy strategy) {
+
+    constexpr double max_cell = (double) ((1u << CURVE_BITS) - 1);
+
+    std::array<uint32_t, 3> x{};
+    for (size_t i = 0; i < 3; ++i) {
+      double extent = box.max[i] - box.min[i];
+      double s = extent > 0.0 ? (p[i] - box.min[i]) / extent : 0.0;
+      x[i] = (uint32_t) std::clamp(s * max_cell, 0.0, max_cell);
+    }
+
+    return strategy == ReorderStrategy::HILBERT ? hilbert_key(x) : morton_key(x);
+
+  }
+
+ private:
+
+  /**
+   * Interleave the bits of three CURVE_BITS-bit integers, most significant
+   * first and x[0] highest within each triple.
+   */
+  static uint64_t
+  interleave(const std::array<uint32_t, 3> &x) {
+
+    auto spread = [](uint64_t v) {
+      v &= 0x1fffff;
+      v = (v | v << 32) & 0x1f00000000ffffULL;
+      v = (v | v << 16) & 0x1f0000ff0000ffULL;
+      v = (v | v << 8) & 0x100f00f00f00f00fULL;
+      v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+      v = (v | v << 2) & 0x1249249249249249ULL;
+      return v;
+    };
+
+    return spread(x[0]) << 2 | spread(x[1]) << 1 | spread(x[2]);
+
+  }
+
+  /**
+   * Compute the reverse Cuthill-McKee order of a mesh's vertices. Each
+   * connected component is started from a pseudo-peripheral vertex found by
+   * repeated breadth first searches (George & Liu).
+   * @param mesh the mesh.
+   * @return the old index of each new vertex.
+   */
+  static vi_list
+  rcm_order(const Mesh &mesh) {
+
+    MeshTopology topology(mesh);
+    const CompressedRows &graph = topology.vertex_vertices();
+
+    size_t n_verts = mesh.vcl().size();
+
+    auto degree = [&](size_t v) { return graph.row(v).size(); };
+
+    vi_list order;
+    order.reserve(n_verts);
+
+    std::vector<uint8_t> visited(n_verts, 0);
+
+    // Breadth first search scratch: the stamp of the search that reached a
+    // vertex, and its level.
+    std::vector<size_t> stamp(n_verts, 0);
+    std::vector<size_t> level(n_verts, 0);
+    size_t search = 0;
+    vi_list queue;
+
+    // Search from `start', return the depth and a minimum degree vertex of the
+    // last level.
+    auto level_structure = [&](size_t start) {
+
+      search++;
+      queue.clear();
+      queue.push_back(start);
+      stamp[start] = search;
+      level[start] = 0;
+
+      for (size_t head = 0; head < queue.size(); ++head) {
+        size_t u = queue[head];
+        for (size_t w : graph.row(u)) {
+          if (stamp[w] == search) continue;
+          stamp[w] = search;
+          level[w] = level[u] + 1;
+          queue.push_back(w);
+        }
+      }
+
+      size_t depth = level[queue.back()];
+      size_t best = queue.back();
+      for (size_t i = queue.size(); i-- > 0 && level[queue[i]] == depth;) {
+        if (degree(queue[i]) < degree(best)) best = queue[i];
+      }
+
+      return std::pair<size_t, size_t>{depth, best};
+
+    };
+
+    vi_list neighbours;
+
+    for (size_t seed = 0; seed < n_verts; ++seed) {
+
+      if (visited[seed]) continue;
+
+      // Find a pseudo-peripheral vertex of the seed's component.
+      size_t start = seed;
+      auto [depth, candidate] = level_structure(start);
+      for (size_t i = 0; i < 8; ++i) {
+        auto [next_depth, next_candidate] = level_structure(candidate);
+        if (next_depth <= depth) break;
+        start = candidate;
+        depth = next_depth;
+        candidate = next_candidate;
+      }
+
+      // Cuthill-McKee: breadth first, neighbours by increasing degree.
+      size_t head = order.size();
+      order.push_back(start);
+      visited[start] = 1;
+
+      for (; head < order.size(); ++head) {
+        neighbours.clear();
+        for (size_t w : graph.row(order[head])) {
+          if (!visited[w]) {
+            visited[w] = 1;
+            neighbours.push_back(w);
+          }
+        }
+        std::stable_sort(neighbours.begin(), neighbours.end(),
+                         [&](size_t a, size_t b) { return degree(a) < degree(b); });
+        order.insert(order.end(), neighbours.begin(), neighbours.end());
+      }
+
+    }
+
+    std::reverse(order.begin(), order.end());
+
+    return order;
+
+  }
+
+  /**
+   * Retrieve the inverse of a permutation.
+   */
+  static vi_list
+  inverse(const vi_list &order) {
+
+    vi_list result(order.size());
+    parallel_for(order.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) result[order[i]] = i;
+    });
+
+    return result;
+
+  }
+
+  /**
+   * Retrieve `values[order[i]]' for each i.
+   */
+  template<typename Values>
+  static std::vector<typename Values::value_type>
+  gather(const Values &values, const vi_list &order) {
+
+    std::vector<typename Values::value_type> result(order.size());
+    parallel_for(order.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) result[i] = values[order[i]];
+    });
+
+    return result;
+
+  }
+
+  /**
+   * Retrieve the second member of each sorted key/index pair.
+   */
+  static vi_list
+  seconds(const std::vector<std::pair<uint64_t, size_t>> &keys) {
+
+    vi_list result(keys.size());
+    parallel_for(keys.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) result[i] = keys[i].second;
+    });
+
+    return result;
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_REORDER_HPP_
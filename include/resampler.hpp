@@ -0,0 +1,278 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_RESAMPLER_HPP_
+#define MFC_INCLUDE_RESAMPLER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <exception>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "aliases.hpp"
+#include "field.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "parallel.hpp"
+#include "tet_bvh.hpp"
+
+/**
+ * Object that will be thrown on resampling exception.
+ */
+class GridResamplerException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  GridResamplerException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * A regular, cell centred grid: cell (i, j, k) has its centre at
+ * min + (i + 1/2, j + 1/2, k + 1/2) * step.
+ */
+struct RegularGrid {
+
+  vert min{};
+
+  vert step{};
+
+  std::array<size_t, 3> n{};
+
+  /**
+   * Retrieve the number of cells in the grid.
+   */
+  [[nodiscard]] size_t
+  size() const { return n[0] * n[1] * n[2]; }
+
+  /**
+   * Retrieve the centre of a cell, cells are numbered with x fastest.
+   * @param idx the index of the cell.
+   * @return the centre of the cell.
+   */
+  [[nodiscard]] vert
+  centre(size_t idx) const {
+
+    size_t i = idx % n[0];
+    size_t j = (idx / n[0]) % n[1];
+    size_t k = idx / (n[0] * n[1]);
+
+    return {
+        min[0] + ((double) i + 0.5) * step[0],
+        min[1] + ((double) j + 0.5) * step[1],
+        min[2] + ((double) k + 0.5) * step[2]
+    };
+
+  }
+
+};
+
+/**
+ * Resamples fields defined on the vertices of a tetrahedral mesh on to a
+ * regular grid by linear (barycentric) interpolation.
+ *
+ * Every grid point is located once, when the resampler is constructed, and
+ * the vertex indices and weights of its tetrahedron are cached. Resampling a
+ * field is then a branch free weighted gather of four vectors per grid point.
+ * Grid points outside the mesh have zero weights and resample to zero.
+ */
+class GridResampler {
+
+ public:
+
+  /**
+   * Create a resampler, this locates all of the grid's points in the mesh.
+   * @param mesh the mesh.
+   * @param grid the grid.
+   */
+  GridResampler(const Mesh &mesh, RegularGrid grid) :
+      _grid(grid),
+      _n_verts(mesh.vcl().size()),
+      _weights(grid.size()) {
+
+    TetBVH bvh(mesh);
+
+    const auto &til = mesh.til();
+
+    // Locate every grid point in one batch (in Morton order).
+    std::vector<vert> centres(_grid.size());
+    parallel_for(centres.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) centres[i] = _grid.centre(i);
+    });
+
+    std::vector<size_t> tets(centres.size());
+    std::vector<std::array<double, 4>> bary(centres.size());
+    bvh.locate(centres, tets, bary);
+
+    size_t n_threads = n_worker_threads();
+    std::vector<size_t> n_located(n_threads, 0);
+
+    parallel_for(n_threads, [&](size_t t_begin, size_t t_end) {
+      for (size_t t = t_begin; t < t_end; ++t) {
+        size_t begin = t * _grid.size() / n_threads;
+        size_t end = (t + 1) * _grid.size() / n_threads;
+        for (size_t i = begin; i < end; ++i) {
+          if (tets[i] == TetBVH::npos) {
+            _weights[i] = {};
+          } else {
+            _weights[i] = {til[tets[i]], bary[i]};
+            n_located[t]++;
+          }
+        }
+      }
+    }, n_threads);
+
+    for (auto n : n_located) _n_located += n;
+
+  }
+
+  /**
+   * Create a grid over the bounding box of a mesh with cubic cells, and `n'
+   * cells along the longest side of the box.
+   * @param mesh the mesh.
+   * @param n the number of cells along the longest side.
+   * @return the grid.
+   */
+  static RegularGrid
+  fit_grid(const Mesh &mesh, size_t n) {
+
+    if (n == 0) throw GridResamplerException("Grid must have cells.");
+
+    BoundingBox box = bounding_box(mesh.vcl());
+    vert extent = sub(box.max, box.min);
+
+    double longest = std::max({extent[0], extent[1], extent[2]});
+    if (!(longest > 0.0)) throw GridResamplerException("Mesh has no extent.");
+
+    double h = longest / (double) n;
+
+    RegularGrid grid;
+    for (size_t i = 0; i < 3; ++i) {
+      grid.n[i] = std::max<size_t>(1, (size_t) std::ceil(extent[i] / h - 1e-9));
+      grid.step[i] = h;
+      // Centre the grid on the box.
+      grid.min[i] = box.min[i] - 0.5 * ((double) grid.n[i] * h - extent[i]);
+    }
+
+    return grid;
+
+  }
+
+  /**
+   * Retrieve the grid.
+   */
+  [[nodiscard]] const RegularGrid &
+  grid() const { return _grid; }
+
+  /**
+   * Retrieve the number of grid points that lie inside the mesh.
+   */
+  [[nodiscard]] size_t
+  n_located() const { return _n_located; }
+
+  /**
+   * Resample a field on to the grid.
+   * @param field the field, with one vector per mesh vertex.
+   * @param values the resampled vectors, one per grid cell.
+   * @param n_threads the number of threads (0 selects the number of hardware
+   *                  threads).
+   */
+  void
+  resample(const Field &field, fv_list &values, size_t n_threads = 0) const {
+
+    const auto &vectors = field.vectors();
+    if (vectors.size() != _n_verts) {
+      throw GridResamplerException("Field does not have one vector per vertex.");
+    }
+
+    values.resize(_weights.size());
+
+    parallel_for(_weights.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        const auto &w = _weights[i];
+        fv value{0.0, 0.0, 0.0};
+        for (size_t j = 0; j < 4; ++j) {
+          const fv &m = vectors[w.v[j]];
+          value[0] += w.w[j] * m[0];
+          value[1] += w.w[j] * m[1];
+          value[2] += w.w[j] * m[2];
+        }
+        values[i] = value;
+      }
+    }, n_threads);
+
+  }
+
+  /**
+   * Resample every field of a field list, the snapshots are processed in
+   * parallel and each is passed to `sink(index, values)' as soon as it is
+   * ready, so only one grid per thread is held in memory. The sink is called
+   * concurrently from several threads. With fewer snapshots than threads
+   * (e.g. a single snapshot), the threads left over split the grid cells of
+   * each snapshot between them.
+   * @param field_list the field list.
+   * @param sink the function that consumes each resampled field.
+   */
+  template<typename Sink>
+  void
+  resample_all(const FieldList &field_list, Sink &&sink) const {
+
+    const auto &fields = field_list.fields();
+    if (fields.empty()) return;
+
+    size_t n_threads = n_worker_threads();
+    size_t n_field_threads = std::min(n_threads, fields.size());
+    size_t n_cell_threads = std::max<size_t>(1, n_threads / n_field_threads);
+
+    parallel_for(fields.size(), [&](size_t begin, size_t end) {
+      fv_list values;
+      for (size_t i = begin; i < end; ++i) {
+        resample(fields[i], values, n_cell_threads);
+        sink(i, values);
+      }
+    }, n_field_threads);
+
+  }
+
+ private:
+
+  /**
+   * The cached interpolation stencil of a grid point.
+   */
+  struct Weights {
+    std::array<size_t, 4> v{};
+    std::array<double, 4> w{};
+  };
+
+  RegularGrid _grid;
+
+  size_t _n_verts;
+
+  size_t _n_located = 0;
+
+  std::vector<Weights> _weights;
+
+};
+
+#endif //MFC_INCLUDE_RESAMPLER_HPP_
@@ -0,0 +1,165 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_SURFACE_HPP_
+#define MFC_INCLUDE_SURFACE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "aliases.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "mesh_topology.hpp"
+#include "parallel.hpp"
+
+/**
+ * The boundary surface of a mesh: its outer faces and the interfaces between
+ * submeshes, as a triangle mesh over a compacted subset of the vertices.
+ */
+struct Surface {
+
+  // Triangles, indexing `vertex_map'.
+  tri_list triangles;
+
+  // The mesh vertex index of each surface vertex.
+  vi_list vertex_map;
+
+  /**
+   * Gather per-vertex vectors of the mesh on to the surface vertices.
+   * @param values the per-vertex vectors of the mesh (coordinates or a field).
+   * @return the vectors at the surface vertices.
+   */
+  template<typename Values>
+  [[nodiscard]] std::vector<typename Values::value_type>
+  gather(const Values &values) const {
+
+    std::vector<typename Values::value_type> result(vertex_map.size());
+    parallel_for(vertex_map.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) result[i] = values[vertex_map[i]];
+    });
+
+    return result;
+
+  }
+
+};
+
+/**
+ * Extracts the surface of a mesh: faces that belong to exactly one
+ * tetrahedron, or that are shared by tetrahedra in different submeshes.
+ */
+class SurfaceExtractor {
+
+ public:
+
+  /**
+   * Default constructor.
+   */
+  SurfaceExtractor() = default;
+
+  /**
+   * Extract the surface of a mesh. Outer faces are oriented outwards, and
+   * interface faces point away from the tetrahedron with the lowest index.
+   * @param mesh the mesh.
+   * @return the surface.
+   */
+  static Surface
+  extract(const Mesh &mesh) {
+
+    MeshTopology topology(mesh);
+
+    return extract(mesh, topology);
+
+  }
+
+  /**
+   * Extract the surface of a mesh whose topology is already known.
+   * @param mesh the mesh.
+   * @param topology the topology of the mesh.
+   * @return the surface.
+   */
+  static Surface
+  extract(const Mesh &mesh, const MeshTopology &topology) {
+
+    const auto &vcl = mesh.vcl();
+    const auto &til = mesh.til();
+    const auto &sml = mesh.sml();
+    const auto &face_tets = topology.face_tets();
+
+    size_t n_faces = topology.faces().size();
+
+    // Select the surface faces.
+    std::vector<uint8_t> selected(n_faces, 0);
+    parallel_for(n_faces, [&](size_t begin, size_t end) {
+      for (size_t f = begin; f < end; ++f) {
+        auto tets = face_tets.row(f);
+        bool surface = tets.size() == 1;
+        for (size_t i = 1; i < tets.size() && !surface; ++i) {
+          surface = sml[tets[i]] != sml[tets[0]];
+        }
+        selected[f] = surface ? 1 : 0;
+      }
+    });
+
+    std::vector<size_t> face_ids;
+    for (size_t f = 0; f < n_faces; ++f) {
+      if (selected[f]) face_ids.push_back(f);
+    }
+
+    // Orient the triangles and mark their vertices.
+    Surface surface;
+    surface.triangles.resize(face_ids.size());
+    std::vector<uint8_t> used(vcl.size(), 0);
+
+    parallel_for(face_ids.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+
+        size_t f = face_ids[i];
+        size_t t = face_tets.row(f)[0];
+
+        // The vertex of the owning tetrahedron opposite the face.
+        size_t local = 0;
+        while (topology.tet_faces()[t][local] != f) local++;
+        const vert &opposite = vcl[til[t][local]];
+
+        tri face = topology.faces()[f];
+        const vert &a = vcl[face[0]];
+        const vert &b = vcl[face[1]];
+        const vert &c = vcl[face[2]];
+        if (dot(cross(sub(b, a), sub(c, a)), sub(a, opposite)) < 0.0) {
+          std::swap(face[1], face[2]);
+        }
+        surface.triangles[i] = face;
+
+        for (auto v : face) {
+          std::atomic_ref<uint8_t>(used[v]).store(1, std::memory_order_relaxed);
+        }
+
+      }
+    });
+
+    // Compact the vertices.
+    std::vector<size_t> local_index(vcl.size());
+    for (size_t v = 0; v < vcl.size(); ++v) {
+      if (used[v]) {
+        local_index[v] = surface.vertex_map.size();
+        surface.vertex_map.push_back(v);
+      }
+    }
+
+    parallel_for(surface.triangles.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        for (auto &v : surface.triangles[i]) v = local_index[v];
+      }
+    });
+
+    return surface;
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_SURFACE_HPP_
@@ -0,0 +1,450 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_TET_BVH_HPP_
+#define MFC_INCLUDE_TET_BVH_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "aliases.hpp"
+#include "field.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "parallel.hpp"
+#include "radix_sort.hpp"
+#include "reorder.hpp"
+
+class TetBVHException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  TetBVHException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * A bounding volume hierarchy over the tetrahedra of a mesh (a linear BVH:
+ * the tetrahedra are sorted by the Morton code of their centroids and the
+ * binary radix tree over the codes is built with every internal node in
+ * parallel, Karras 2012). Each leaf is one tetrahedron.
+ */
+class TetBVH {
+
+ public:
+
+  // Returned by `locate' for points outside the mesh.
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  /**
+   * Build the hierarchy for a mesh.
+   * @param mesh the mesh, it must outlive the hierarchy.
+   */
+  explicit TetBVH(const Mesh &mesh) :
+      _mesh(mesh) {
+
+    const auto &vcl = mesh.vcl();
+    const auto &til = mesh.til();
+
+    size_t n = til.size();
+
+    if (n >= LEAF_BIT) {
+      throw TetBVHException("Too many tetrahedra for a TetBVH.");
+    }
+
+    if (n == 0) return;
+
+    // Morton codes of the centroids.
+    _box = bounding_box(vcl);
+    std::vector<std::pair<uint64_t, size_t>> codes(n);
+    parallel_for(n, [&](size_t begin, size_t end) {
+      for (size_t t = begin; t < end; ++t) {
+        const tet &e = til[t];
+        vert c = scale(0.25, add(add(vcl[e[0]], vcl[e[1]]), add(vcl[e[2]], vcl[e[3]])));
+        codes[t] = {MeshReorderer::curve_key(c, _box, ReorderStrategy::MORTON), t};
+      }
+    });
+    radix_sort(codes, [](const auto &c) { return c.first; }, 0, 3 * MeshReorderer::CURVE_BITS);
+
+    // Leaves, in Morton order.
+    _leaf_tets.resize(n);
+    std::vector<BoundingBox> leaf_boxes(n);
+    parallel_for(n, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        _leaf_tets[i] = codes[i].second;
+        BoundingBox leaf_box;
+        for (auto v : til[codes[i].second]) leaf_box.extend(vcl[v]);
+        leaf_boxes[i] = leaf_box;
+      }
+    });
+
+    if (n == 1) {
+      _root = LEAF_BIT;
+      return;
+    }
+
+    // Internal nodes, each one independently.
+    _nodes.resize(n - 1);
+    std::vector<uint32_t> parent_of_node(n - 1, 0);
+    std::vector<uint32_t> parent_of_leaf(n, 0);
+
+    parallel_for(n - 1, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        auto [first, last] = node_range(codes, i);
+        size_t split = find_split(codes, first, last);
+        Node &node = _nodes[i];
+        node.child[0] = split == first ? LEAF_BIT | split : split;
+        node.child[1] = split + 1 == last ? LEAF_BIT | (split + 1) : split + 1;
+        for (auto child : node.child) {
+          if (child & LEAF_BIT) {
+            parent_of_leaf[child & ~LEAF_BIT] = i;
+          } else {
+            parent_of_node[child] = i;
+          }
+        }
+      }
+    });
+
+    // Bounding boxes, bottom up: the second child to arrive at a node
+    // computes the node's box and stores it in the parent.
+    std::vector<uint8_t> arrived(n - 1, 0);
+    parallel_for(n, [&](size_t begin, size_t end) {
+      for (size_t leaf = begin; leaf < end; ++leaf) {
+        uint32_t node = parent_of_leaf[leaf];
+        set_child_box(node, LEAF_BIT | leaf, leaf_boxes[leaf]);
+        while (true) {
+          if (std::atomic_ref<uint8_t>(arrived[node]).fetch_add(1, std::memory_order_acq_rel) == 0) {
+            break;
+          }
+          if (node == 0) break;
+          BoundingBox node_box = _nodes[node].box[0];
+          node_box.extend(_nodes[node].box[1]);
+          uint32_t parent = parent_of_node[node];
+          set_child_box(parent, node, node_box);
+          node = parent;
+        }
+      }
+    });
+
+    _root = 0;
+    _depth = tree_depth();
+
+  }
+
+  /**
+   * Find the tetrahedron that contains a point.
+   * @param p the point.
+   * @param bary the barycentric coordinates of the point in the tetrahedron.
+   * @param eps the tolerance for points on (or very near) a face.
+   * @return the index of the tetrahedron, or `npos' if p is outside the mesh.
+   */
+  size_t
+  locate(const vert &p, std::array<double, 4> &bary, double eps = 1e-10) const {
+
+    if (_leaf_tets.empty()) return npos;
+    if (!contains(_box, p, eps)) return npos;
+
+    const auto &vcl = _mesh.vcl();
+    const auto &til = _mesh.til();
+
+    // A depth first traversal holds at most one pending sibling per level,
+    // so the fixed stack covers any reasonable tree; a degenerate one (e.g.
+    // from many duplicate Morton codes) gets a stack on the heap.
+    std::array<uint32_t, STACK_SIZE> fixed_stack{};
+    std::vector<uint32_t> heap_stack;
+    uint32_t *stack = fixed_stack.data();
+    if (_depth + 2 > STACK_SIZE) {
+      heap_stack.resize(_depth + 2);
+      stack = heap_stack.data();
+    }
+
+    size_t top = 0;
+    stack[top++] = _root;
+
+    while (top > 0) {
+
+      uint32_t id = stack[--top];
+
+      if (id & LEAF_BIT) {
+        uint32_t leaf = id & ~LEAF_BIT;
+        const tet &t = til[_leaf_tets[leaf]];
+        if (!barycentric(vcl[t[0]], vcl[t[1]], vcl[t[2]], vcl[t[3]], p, bary)) continue;
+        if (bary[0] >= -eps && bary[1] >= -eps && bary[2] >= -eps && bary[3] >= -eps) {
+          return _leaf_tets[leaf];
+        }
+        continue;
+      }
+
+      const Node &node = _nodes[id];
+      if (contains(node.box[1], p, eps)) stack[top++] = node.child[1];
+      if (contains(node.box[0], p, eps)) stack[top++] = node.child[0];
+
+    }
+
+    return npos;
+
+  }
+
+  /**
+   * Locate many points, in parallel. The points are visited in Morton order,
+   * so that consecutive queries walk the same parts of the hierarchy and of
+   * the mesh while they are still in cache.
+   * @param points the points.
+   * @param tets the containing tetrahedron of each point (or `npos').
+   * @param bary the barycentric coordinates of each point.
+   * @param eps the tolerance for points on (or very near) a face.
+   */
+  void
+  locate(std::span<const vert> points,
+         std::span<size_t> tets,
+         std::span<std::array<double, 4>> bary,
+         double eps = 1e-10) const {
+
+    for_each_located(points, eps, [&](size_t i, size_t t, const std::array<double, 4> &b) {
+      tets[i] = t;
+      bary[i] = b;
+    });
+
+  }
+
+  /**
+   * Interpolate a field (linearly, within each tetrahedron) at many points.
+   * @param points the points.
+   * @param field the field, with one vector per mesh vertex.
+   * @param outside the value for points outside the mesh.
+   * @return the field at each point.
+   */
+  [[nodiscard]] fv_list
+  probe(std::span<const vert> points,
+        const Field &field,
+        const fv &outside = {
+            std::numeric_limits<double>::quiet_NaN(),
+            std::numeric_limits<double>::quiet_NaN(),
+            std::numeric_limits<double>::quiet_NaN()
+        }) const {
+
+    const auto &til = _mesh.til();
+    const auto &vectors = field.vectors();
+
+    if (vectors.size() != _mesh.vcl().size()) {
+      throw TetBVHException("Field does not match the mesh.");
+    }
+
+    fv_list result(points.size());
+    for_each_located(points, 1e-10, [&](size_t i, size_t t, const std::array<double, 4> &bary) {
+      if (t == npos) {
+        result[i] = outside;
+        return;
+      }
+      fv value{0.0, 0.0, 0.0};
+      for (size_t k = 0; k < 4; ++k) {
+        value = add(value, scale(bary[k], vectors[til[t][k]]));
+      }
+      result[i] = value;
+    });
+
+    return result;
+
+  }
+
+  /**
+   * Retrieve the number of internal nodes.
+   */
+  [[nodiscard]] size_t
+  n_nodes() const { return _nodes.size(); }
+
+ private:
+
+  // Child ids with this bit set are leaves.
+  static constexpr uint32_t LEAF_BIT = 0x80000000u;
+
+  // The size of the traversal stack that `locate' keeps on the call stack.
+  static constexpr size_t STACK_SIZE = 128;
+
+  /**
+   * An internal node: the boxes of its two children and their ids, so that
+   * a child is only fetched if the query point is inside its box.
+   */
+  struct Node {
+    std::array<BoundingBox, 2> box;
+    std::array<uint32_t, 2> child{};
+  };
+
+  const Mesh &_mesh;
+
+  std::vector<Node> _nodes;
+
+  std::vector<size_t> _leaf_tets;
+
+  BoundingBox _box;
+
+  uint32_t _root = 0;
+
+  // The number of internal nodes on the longest path from the root to a leaf.
+  size_t _depth = 0;
+
+  /**
+   * Retrieve the number of internal nodes on the longest path from the root
+   * to a leaf (of a tree with at least one internal node).
+   */
+  [[nodiscard]] size_t
+  tree_depth() const {
+
+    size_t depth = 0;
+
+    std::vector<std::pair<uint32_t, size_t>> pending{{_root, 1}};
+    while (!pending.empty()) {
+      auto [id, level] = pending.back();
+      pending.pop_back();
+      depth = std::max(depth, level);
+      for (auto child : _nodes[id].child) {
+        if (!(child & LEAF_BIT)) pending.emplace_back(child, level + 1);
+      }
+    }
+
+    return depth;
+
+  }
+
+  /**
+   * Retrieve true if a box (grown by eps) contains a point.
+   */
+  static bool
+  contains(const BoundingBox &box, const vert &p, double eps) {
+    return p[0] >= box.min[0] - eps && p[0] <= box.max[0] + eps
+        && p[1] >= box.min[1] - eps && p[1] <= box.max[1] + eps
+        && p[2] >= box.min[2] - eps && p[2] <= box.max[2] + eps;
+  }
+
+  /**
+   * Locate many points, in parallel and in Morton order, calling
+   * `fn(i, tet, bary)' for each point i.
+   */
+  template<typename Fn>
+  void
+  for_each_located(std::span<const vert> points, double eps, Fn fn) const {
+
+    std::vector<std::pair<uint64_t, size_t>> order(points.size());
+    parallel_for(points.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        order[i] = {MeshReorderer::curve_key(points[i], _box, ReorderStrategy::MORTON), i};
+      }
+    });
+    radix_sort(order, [](const auto &o) { return o.first; }, 0, 3 * MeshReorderer::CURVE_BITS);
+
+    parallel_for(order.size(), [&](size_t begin, size_t end) {
+      std::array<double, 4> bary{};
+      for (size_t k = begin; k < end; ++k) {
+        size_t i = order[k].second;
+        size_t t = locate(points[i], bary, eps);
+        fn(i, t, bary);
+      }
+    });
+
+  }
+
+  /**
+   * Store the box of a child in its parent.
+   */
+  void
+  set_child_box(uint32_t parent, uint32_t child, const BoundingBox &box) {
+    Node &node = _nodes[parent];
+    node.box[node.child[0] == child ? 0 : 1] = box;
+  }
+
+  /**
+   * Retrieve the length of the longest common prefix of the keys at i and j,
+   * (ties broken by index), or -1 if j is out of range.
+   */
+  static int
+  delta(const std::vector<std::pair<uint64_t, size_t>> &codes, size_t i, int64_t j) {
+
+    if (j < 0 || j >= (int64_t) codes.size()) return -1;
+
+    uint64_t a = codes[i].first;
+    uint64_t b = codes[j].first;
+    if (a == b) return 64 + __builtin_clzll((uint64_t) i ^ (uint64_t) j);
+
+    return __builtin_clzll(a ^ b);
+
+  }
+
+  /**
+   * Retrieve the range of leaves [first, last] covered by internal node i.
+   */
+  static std::pair<size_t, size_t>
+  node_range(const std::vector<std::pair<uint64_t, size_t>> &codes, size_t i) {
+
+    if (i == 0) return {0, codes.size() - 1};
+
+    int64_t ii = (int64_t) i;
+    int64_t d = delta(codes, i, ii + 1) > delta(codes, i, ii - 1) ? 1 : -1;
+    int delta_min = delta(codes, i, ii - d);
+
+    int64_t l_max = 2;
+    while (delta(codes, i, ii + l_max * d) > delta_min) l_max *= 2;
+
+    int64_t l = 0;
+    for (int64_t t = l_max / 2; t >= 1; t /= 2) {
+      if (delta(codes, i, ii + (l + t) * d) > delta_min) l += t;
+    }
+
+    int64_t j = ii + l * d;
+
+    return {(size_t) std::min(ii, j), (size_t) std::max(ii, j)};
+
+  }
+
+  /**
+   * Retrieve the last leaf of the left child of the node covering
+   * [first, last]: the position of the highest differing prefix bit.
+   */
+  static size_t
+  find_split(const std::vector<std::pair<uint64_t, size_t>> &codes, size_t first, size_t last) {
+
+    int common = delta(codes, first, (int64_t) last);
+
+    size_t split = first;
+    size_t step = last - first;
+    do {
+      step = (step + 1) / 2;
+      size_t candidate = split + step;
+      if (candidate < last && delta(codes, first, (int64_t) candidate) > common) {
+        split = candidate;
+      }
+    } while (step > 1);
+
+    return split;
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_TET_BVH_HPP_
@@ -0,0 +1,285 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_VECTOR_ARRAY_HPP_
+#define MFC_INCLUDE_VECTOR_ARRAY_HPP_
+
+#include <algorithm>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "aliases.hpp"
+#include "parallel.hpp"
+
+/**
+ * The memory layouts of an array of 3-vectors.
+ */
+enum class VectorLayout {
+  AOS,     // x0 y0 z0 x1 y1 z1 ...
+  SOA,     // x0 x1 ... y0 y1 ... z0 z1 ...
+  AOSOA8   // x0..x7 y0..y7 z0..z7 x8..x15 ...
+};
+
+/**
+ * A non-owning, read only view of an array of 3-vectors in any layout. All of
+ * the layouts are blocks of `block' vectors, each block storing its x
+ * components, then its y components and then its z components: AoS has
+ * blocks of one and SoA a single block of every vector.
+ */
+class VectorView {
+
+ public:
+
+  /**
+   * Create a view.
+   * @param data the first component of the first vector.
+   * @param size the number of vectors.
+   * @param block the number of vectors per block.
+   */
+  VectorView(const double *data, size_t size, size_t block) :
+      _data(data), _size(size), _block(block == 0 ? 1 : block) {}
+
+  /**
+   * Create a view of a list of vectors (AoS).
+   * @param vectors the vectors.
+   */
+  VectorView(const std::vector<vert> &vectors) :
+      VectorView(std::span<const vert>(vectors)) {}
+
+  /**
+   * Create a view of a span of vectors (AoS), e.g. a field's vectors.
+   * @param vectors the vectors.
+   */
+  VectorView(std::span<const vert> vectors) :
+      VectorView(vectors.empty() ? nullptr : vectors[0].data(), vectors.size(), 1) {}
+
+  /**
+   * Retrieve the number of vectors.
+   */
+  [[nodiscard]] size_t
+  size() const { return _size; }
+
+  /**
+   * Retrieve the number of vectors per block.
+   */
+  [[nodiscard]] size_t
+  block() const { return _block; }
+
+  /**
+   * Retrieve the underlying data.
+   */
+  [[nodiscard]] const double *
+  data() const { return _data; }
+
+  /**
+   * Retrieve the number of doubles spanned by the view, including the padding
+   * of a partial last block.
+   */
+  [[nodiscard]] size_t
+  extent() const { return 3 * _block * ((_size + _block - 1) / _block); }
+
+  /**
+   * Retrieve a component of a vector.
+   * @param i the vector index.
+   * @param c the component (0, 1 or 2).
+   */
+  [[nodiscard]] double
+  operator()(size_t i, size_t c) const {
+    return _data[(i / _block) * 3 * _block + c * _block + i % _block];
+  }
+
+  /**
+   * Retrieve a vector.
+   * @param i the vector index.
+   */
+  [[nodiscard]] vert
+  operator[](size_t i) const {
+    return {(*this)(i, 0), (*this)(i, 1), (*this)(i, 2)};
+  }
+
+ private:
+
+  const double *_data;
+
+  size_t _size;
+
+  size_t _block;
+
+};
+
+/**
+ * An array of 3-vectors stored in the given layout.
+ */
+template<VectorLayout Layout>
+class VectorArray {
+
+ public:
+
+  /**
+   * Create an empty array.
+   */
+  VectorArray() = default;
+
+  /**
+   * Create an array of `n' zero vectors.
+   * @param n the number of vectors.
+   */
+  explicit VectorArray(size_t n) :
+      _size(n), _data(padded(n)) {}
+
+  /**
+   * Create an array from separate component lists, with SoA layout these are
+   * stored without any transposition.
+   * @param x the x components.
+   * @param y the y components.
+   * @param z the z components.
+   */
+  VectorArray(std::vector<double> x, std::vector<double> y, std::vector<double> z) :
+      _size(x.size()) {
+
+    if constexpr (Layout == VectorLayout::SOA) {
+      _data = std::move(x);
+      _data.insert(_data.end(), y.begin(), y.end());
+      _data.insert(_data.end(), z.begin(), z.end());
+    } else {
+      _data.resize(padded(_size));
+      parallel_for(_size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) set(i, {x[i], y[i], z[i]});
+      });
+    }
+
+  }
+
+  /**
+   * Create an array with a copy of the vectors of a view (any layout), a view
+   * in this array's layout is copied as it is.
+   * @param view the view.
+   */
+  explicit VectorArray(const VectorView &view) :
+      _size(view.size()), _data(padded(view.size())) {
+
+    if (_size > 0 && view.block() == block()) {
+      std::copy_n(view.data(), view.extent(), _data.begin());
+      return;
+    }
+
+    parallel_for(_size, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) set(i, view[i]);
+    });
+
+  }
+
+  /**
+   * Retrieve the number of vectors.
+   */
+  [[nodiscard]] size_t
+  size() const { return _size; }
+
+  /**
+   * Retrieve the number of vectors per block.
+   */
+  [[nodiscard]] size_t
+  block() const {
+    if constexpr (Layout == VectorLayout::AOS) return 1;
+    if constexpr (Layout == VectorLayout::AOSOA8) return 8;
+    return _size;
+  }
+
+  /**
+   * Retrieve a component of a vector.
+   */
+  [[nodiscard]] double
+  operator()(size_t i, size_t c) const { return _data[index(i, c)]; }
+
+  /**
+   * Retrieve a component of a vector.
+   */
+  double &
+  operator()(size_t i, size_t c) { return _data[index(i, c)]; }
+
+  /**
+   * Retrieve a vector.
+   */
+  [[nodiscard]] vert
+  operator[](size_t i) const {
+    return {_data[index(i, 0)], _data[index(i, 1)], _data[index(i, 2)]};
+  }
+
+  /**
+   * Set a vector.
+   */
+  void
+  set(size_t i, const vert &v) {
+    for (size_t c = 0; c < 3; ++c) _data[index(i, c)] = v[c];
+  }
+
+  /**
+   * Retrieve one component of every vector as a contiguous span (SoA only),
+   * loops over this vectorize fully.
+   * @param c the component.
+   */
+  [[nodiscard]] std::span<const double>
+  component(size_t c) const requires (Layout == VectorLayout::SOA) {
+    return {_data.data() + c * _size, _size};
+  }
+
+  /**
+   * Retrieve one component of every vector as a contiguous span (SoA only).
+   * @param c the component.
+   */
+  std::span<double>
+  component(size_t c) requires (Layout == VectorLayout::SOA) {
+    return {_data.data() + c * _size, _size};
+  }
+
+  /**
+   * Retrieve a view of this array.
+   */
+  [[nodiscard]] VectorView
+  view() const { return {_data.data(), _size, block()}; }
+
+  /**
+   * Retrieve the vectors as a list (AoS).
+   */
+  [[nodiscard]] std::vector<vert>
+  to_list() const {
+
+    std::vector<vert> result(_size);
+    parallel_for(_size, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) result[i] = (*this)[i];
+    });
+
+    return result;
+
+  }
+
+ private:
+
+  size_t _size = 0;
+
+  std::vector<double> _data;
+
+  /**
+   * Retrieve the position of a component of a vector in `_data'.
+   */
+  [[nodiscard]] size_t
+  index(size_t i, size_t c) const {
+    if constexpr (Layout == VectorLayout::AOS) return 3 * i + c;
+    if constexpr (Layout == VectorLayout::AOSOA8) return (i >> 3) * 24 + c * 8 + (i & 7);
+    return c * _size + i;
+  }
+
+  /**
+   * Retrieve the number of doubles needed for `n' vectors.
+   */
+  static size_t
+  padded(size_t n) {
+    if constexpr (Layout == VectorLayout::AOSOA8) return 24 * ((n + 7) / 8);
+    return 3 * n;
+  }
+
+};
+
+#endif //MFC_INCLUDE_VECTOR_ARRAY_HPP_
@@ -5,14 +5,29 @@
 #ifndef MFC_INCLUDE_WRITER_MICROMAG_HPP_
 #define MFC_INCLUDE_WRITER_MICROMAG_HPP_
 
+#include <algorithm>
+#include <cstdint>
 #include <exception>
+#include <filesystem>
+#include <iomanip>
 #include <string>
 #include <sstream>
 
+#include <unistd.h>
+
 #include <H5Cpp.h>
 
 #include "aliases.hpp"
+#include "hdf5_vectors.hpp"
+#include "hdf5_blocks.hpp"
+#include "hdf5_links.hpp"
+#include "hdf5_options.hpp"
+#include "index_width.hpp"
+#include "mapped_model.hpp"
+#include "mesh_hash.hpp"
 #include "model.hpp"
+#include "precision.hpp"
+#include "surface.hpp"
 
 /**
  * Object that will be thrown on micromagnetic model file `*.mmf' writing
@@ -55,16 +70,150 @@ class MicromagFileWriter {
    */
   MicromagFileWriter() = default;
 
+  // Writes the mesh (& surface) of a live file before appending its fields.
+  friend class MicromagSeriesWriter;
+
   /**
    * Function that will write a file.
+   * @param file_name the name of the file.
+   * @param model the model.
+   * @param precision the precision of the stored coordinates and fields.
+   * @param mesh_store if given, a mesh store directory: the mesh is written
+   *                   there once (see `store_mesh') and linked to.
+   * @param options the file format and metadata layout options.
    */
   static void
-  write(const std::string &file_name, const Model &model) {
+  write(const std::string &file_name,
+        const Model &model,
+        Precision precision = Precision::DOUBLE,
+        const std::string &mesh_store = "",
+        const HDF5FileOptions &options = {}) {
 
-    H5::H5File file(file_name, H5F_ACC_TRUNC);
+    H5::H5File file(file_name, H5F_ACC_TRUNC, options.create_properties(), options.access_properties());
+
+    // Write the mesh.
+    write_mesh(file, model, precision, mesh_store, options);
+
+  }
+
+  /**
+   * Function that will write a file, including the model's surface.
+   * @param file_name the name of the file.
+   * @param model the model.
+   * @param surface the surface of the model's mesh.
+   * @param precision the precision of the stored coordinates and fields.
+   * @param mesh_store if given, a mesh store directory: the mesh is written
+   *                   there once (see `store_mesh') and linked to.
+   * @param options the file format and metadata layout options.
+   */
+  static void
+  write(const std::string &file_name,
+        const Model &model,
+        const Surface &surface,
+        Precision precision = Precision::DOUBLE,
+        const std::string &mesh_store = "",
+        const HDF5FileOptions &options = {}) {
+
+    H5::H5File file(file_name, H5F_ACC_TRUNC, options.create_properties(), options.access_properties());
 
     // Write the mesh.
-    write_mesh(file, model);
+    write_mesh(file, model, precision, mesh_store, options);
+
+    // Write the surface.
+    write_surface(file, model, surface, precision, options);
+
+  }
+
+  /**
+   * Function that will write an out-of-core model to a file, a block of rows
+   * at a time, so that only about one block of each array is resident at
+   * once. The layout is the same as for an in-memory model, including the
+   * original indices of a reordered mesh and the mesh's hash tag.
+   * @param file_name the name of the file.
+   * @param model the out-of-core model.
+   * @param rows_per_block the number of rows written per block.
+   * @param precision the precision of the stored coordinates and fields.
+   */
+  static void
+  write_mapped(const std::string &file_name,
+               const MappedModel &model,
+               hsize_t rows_per_block = hsize_t{1} << 20,
+               Precision precision = Precision::DOUBLE) {
+
+    H5::H5File file(file_name, H5F_ACC_TRUNC);
+
+    H5::Group grp_mesh(file.createGroup("/mesh"));
+
+    // The mesh's content hash, if the source was tagged with one.
+    if (model.hash) {
+      H5::DataSpace dsp_hash(H5S_SCALAR);
+      H5::Attribute att_hash = grp_mesh.createAttribute("hash", H5::PredType::NATIVE_UINT64, dsp_hash);
+      att_hash.write(H5::PredType::NATIVE_UINT64, &*model.hash);
+    }
+
+    // Vertices.
+    hsize_t dim_vertices[2] = {model.vcl.size(), 3};
+    H5::DataSpace dsp_vertices(2, dim_vertices);
+    H5::DataSet ds_vertices(
+        file.createDataSet("/mesh/vertices", precision_type(precision), dsp_vertices)
+    );
+    write_blocks(model.vcl, ds_vertices, rows_per_block);
+
+    // Elements, with the narrowest type that holds every vertex index, the
+    // largest index is found with one streaming pass.
+    uint64_t max_index = 0;
+    model.til.advise(MappedAccess::SEQUENTIAL);
+    for (size_t first = 0; first < model.til.size(); first += rows_per_block) {
+      size_t count = std::min<size_t>(rows_per_block, model.til.size() - first);
+      for (size_t i = first; i < first + count; ++i) {
+        for (auto index : model.til[i]) max_index = std::max<uint64_t>(max_index, index);
+      }
+      model.til.release(first, count);
+    }
+
+    hsize_t dim_elements[2] = {model.til.size(), 4};
+    H5::DataSpace dsp_elements(2, dim_elements);
+    H5::DataSet ds_elements(
+        file.createDataSet("/mesh/elements", index_type(index_bytes(max_index)), dsp_elements)
+    );
+    write_blocks(model.til, ds_elements, rows_per_block);
+
+    // Submesh indices, the widest id is found with one streaming pass.
+    uint64_t max_id = 0;
+    model.sml.advise(MappedAccess::SEQUENTIAL);
+    for (size_t first = 0; first < model.sml.size(); first += rows_per_block) {
+      size_t count = std::min<size_t>(rows_per_block, model.sml.size() - first);
+      for (size_t i = first; i < first + count; ++i) max_id = std::max<uint64_t>(max_id, model.sml[i]);
+      model.sml.release(first, count);
+    }
+
+    hsize_t dim_submesh_idxs[1] = {model.sml.size()};
+    H5::DataSpace dsp_submesh_idxs(1, dim_submesh_idxs);
+    H5::DataSet ds_submesh_idxs(
+        file.createDataSet("/mesh/submesh", index_type(index_bytes(max_id)), dsp_submesh_idxs)
+    );
+    write_blocks(model.sml, ds_submesh_idxs, rows_per_block);
+
+    // The original vertex & element indices of a reordered mesh.
+    write_mapped_index_list(file, "/mesh/vertex_ids", model.vertex_ids, rows_per_block);
+    write_mapped_index_list(file, "/mesh/element_ids", model.element_ids, rows_per_block);
+
+    // Fields.
+    H5::Group grp_fields(file.createGroup("/fields"));
+    for (size_t i = 0; i < model.fields.size(); ++i) {
+
+      std::stringstream ss_field;
+      ss_field << "/fields/field" << i;
+      H5::Group grp_field(file.createGroup(ss_field.str()));
+
+      hsize_t dim_vectors[2] = {model.fields[i].size(), 3};
+      H5::DataSpace dsp_vectors(2, dim_vectors);
+      H5::DataSet ds_vectors(
+          file.createDataSet(ss_field.str() + "/vectors", precision_type(precision), dsp_vectors)
+      );
+      write_blocks(model.fields[i], ds_vectors, rows_per_block);
+
+    }
 
   }
 
@@ -74,15 +223,54 @@ class MicromagFileWriter {
    * Write the model's mesh to the file.
    * @param file the HDF5 file handle.
    * @param model the model.
+   * @param precision the precision of the stored coordinates and fields.
+   * @param mesh_store the mesh store directory (if empty, the mesh is written
+   *                   to the file itself).
+   * @param options the file format and metadata layout options.
+   */
+  static void
+  write_mesh(H5::H5File &file,
+             const Model &model,
+             Precision precision,
+             const std::string &mesh_store,
+             const HDF5FileOptions &options) {
+
+    if (mesh_store.empty()) {
+      write_mesh_arrays(file, model, precision, mesh_hash(model.mesh()));
+    } else {
+      link_mesh(file, store_mesh(mesh_store, model, precision));
+    }
+
+    // Write fields.
+    write_fields(file, model, precision, options);
+
+  }
+
+  /**
+   * Write the model's mesh to the `/mesh' group of a file, tagged with the
+   * mesh's content hash (the `hash' attribute) so that readers can recognise
+   * a mesh they have already loaded.
+   * @param file the HDF5 file handle.
+   * @param model the model.
+   * @param precision the precision of the stored coordinates.
+   * @param hash the mesh's content hash.
    */
   static void
-  write_mesh(H5::H5File &file, const Model &model) {
+  write_mesh_arrays(H5::H5File &file, const Model &model, Precision precision, uint64_t hash) {
 
     // Create a group for the mesh.
     H5::Group grp_mesh(file.createGroup("/mesh"));
 
+    H5::DataSpace dsp_hash(H5S_SCALAR);
+    H5::Attribute att_hash = grp_mesh.createAttribute(
+        "hash",
+        H5::PredType::NATIVE_UINT64,
+        dsp_hash
+    );
+    att_hash.write(H5::PredType::NATIVE_UINT64, &hash);
+
     // Write the vertices.
-    write_vertices(file, model);
+    write_vertices(file, model, precision);
 
     // Write the elements.
     write_elements(file, model);
@@ -90,34 +278,81 @@ class MicromagFileWriter {
     // Write the submesh indices.
     write_submesh_indices(file, model);
 
-    // Write fields.
-    write_fields(file, model);
+    // Write the original vertex & element indices of a reordered mesh.
+    write_index_list(file, "/mesh/vertex_ids", model.mesh().vertex_ids());
+    write_index_list(file, "/mesh/element_ids", model.mesh().element_ids());
 
   }
 
   /**
-   * Write the model mesh's vertices to the file.
-   * @param file the HDF5 file handle.
+   * Write a model's mesh to a content addressed mesh store: a directory of
+   * `<hash>.h5' files (`<hash>.f32.h5' at single precision) that each hold
+   * one mesh in a `/mesh' group. A mesh that is already in the store is not
+   * written again. New entries are written to a temporary file and renamed
+   * in to place, so that concurrent writers of the same mesh are safe.
+   * @param mesh_store the store directory (created if missing).
    * @param model the model.
+   * @param precision the precision of the stored coordinates.
+   * @return the path of the mesh's store file.
+   */
+  static std::filesystem::path
+  store_mesh(const std::string &mesh_store, const Model &model, Precision precision) {
+
+    uint64_t hash = mesh_hash(model.mesh());
+
+    std::stringstream ss_name;
+    ss_name << std::hex << std::setw(16) << std::setfill('0') << hash
+            << (precision == Precision::SINGLE ? ".f32.h5" : ".h5");
+
+    std::filesystem::create_directories(mesh_store);
+    std::filesystem::path path = std::filesystem::path(mesh_store) / ss_name.str();
+
+    if (!std::filesystem::exists(path)) {
+
+      std::filesystem::path tmp_path = path;
+      tmp_path += ".tmp" + std::to_string(::getpid());
+
+      {
+        H5::H5File store(tmp_path.string(), H5F_ACC_TRUNC);
+        write_mesh_arrays(store, model, precision, hash);
+      }
+
+      std::filesystem::rename(tmp_path, path);
+
+    }
+
+    return path;
+
+  }
+
+  /**
+   * Make a file's `/mesh' an external link to the `/mesh' group of a mesh
+   * store file (by its path relative to the file, see `link_target').
+   * @param file the HDF5 file handle.
+   * @param path the path of the mesh store file.
    */
   static void
-  write_vertices(H5::H5File &file, const Model &model) {
+  link_mesh(H5::H5File &file, const std::filesystem::path &path) {
 
-    // Create a vertices dataset in the mesh group.
-    hsize_t dim_vertices[2];
-    dim_vertices[0] = model.mesh().vcl().size();
-    dim_vertices[1] = 3;
+    std::string target = link_target(file, path);
 
-    H5::DataSpace dsp_vertices(2, dim_vertices);
-    H5::DataSet ds_vertices(
-        file.createDataSet(
-            "/mesh/vertices",
-            H5::PredType::NATIVE_DOUBLE,
-            dsp_vertices
-        )
-    );
+    if (H5Lcreate_external(target.c_str(), "/mesh", file.getId(), "/mesh", H5P_DEFAULT, H5P_DEFAULT) < 0) {
+      throw MicromagFileWriterException("Could not link '/mesh' to '" + target + "'.");
+    }
 
-    ds_vertices.write(model.mesh().vcl().data(), H5::PredType::NATIVE_DOUBLE);
+  }
+
+  /**
+   * Write the model mesh's vertices to the file.
+   * @param file the HDF5 file handle.
+   * @param model the model.
+   * @param precision the precision of the stored coordinates.
+   */
+  static void
+  write_vertices(H5::H5File &file, const Model &model, Precision precision) {
+
+    // Write the vertices to the mesh group.
+    write_vectors(file, "/mesh/vertices", VectorView(model.mesh().vcl()), precision_type(precision));
 
   }
 
@@ -134,11 +369,13 @@ class MicromagFileWriter {
     dim_elements[0] = model.mesh().til().size();
     dim_elements[1] = 4;
 
+    // Use the narrowest type that holds every vertex index, HDF5 converts
+    // from the in memory 64-bit indices while writing.
     H5::DataSpace dsp_elements(2, dim_elements);
     H5::DataSet ds_elements(
         file.createDataSet(
             "/mesh/elements",
-            H5::PredType::NATIVE_UINT64,
+            index_type(element_index_bytes(model.mesh())),
             dsp_elements
         )
     );
@@ -164,7 +401,7 @@ class MicromagFileWriter {
     H5::DataSet ds_submesh_idxs(
         file.createDataSet(
             "/mesh/submesh",
-            H5::PredType::NATIVE_UINT64,
+            index_type(submesh_index_bytes(model.mesh())),
             dsp_submesh_idxs
         )
     );
@@ -176,22 +413,172 @@ class MicromagFileWriter {
 
   }
 
+  /**
+   * Write a file backed list of indices to the file, a block of rows at a
+   * time; nothing is written if it is empty.
+   * @param file the HDF5 file handle.
+   * @param data_set_name the name of the data set.
+   * @param indices the indices.
+   * @param rows_per_block the number of rows written per block.
+   */
   static void
-  write_fields(H5::H5File &file, const Model &model) {
+  write_mapped_index_list(H5::H5File &file,
+                          const std::string &data_set_name,
+                          const MappedArray<size_t> &indices,
+                          hsize_t rows_per_block) {
+
+    if (indices.size() == 0) return;
+
+    hsize_t dim_indices[1] = {indices.size()};
+    H5::DataSpace dsp_indices(1, dim_indices);
+    H5::DataSet ds_indices(file.createDataSet(data_set_name, H5::PredType::NATIVE_UINT64, dsp_indices));
+    write_blocks(indices, ds_indices, rows_per_block);
+
+  }
+
+  /**
+   * Write a list of indices to the file, nothing is written if it is empty.
+   * @param file the HDF5 file handle.
+   * @param data_set_name the name of the data set.
+   * @param indices the indices.
+   */
+  static void
+  write_index_list(H5::H5File &file,
+                   const std::string &data_set_name,
+                   const vi_list &indices) {
+
+    if (indices.empty()) return;
+
+    hsize_t dim_indices[1];
+    dim_indices[0] = indices.size();
+
+    H5::DataSpace dsp_indices(1, dim_indices);
+    H5::DataSet ds_indices(
+        file.createDataSet(
+            data_set_name,
+            H5::PredType::NATIVE_UINT64,
+            dsp_indices
+        )
+    );
+
+    ds_indices.write(indices.data(), H5::PredType::NATIVE_UINT64);
+
+  }
+
+  /**
+   * Write the surface triangles, their vertices, the map from surface vertices
+   * to mesh vertices and the fields restricted to the surface vertices.
+   * @param file the HDF5 file handle.
+   * @param model the model.
+   * @param surface the surface of the model's mesh.
+   * @param precision the precision of the stored coordinates and fields.
+   * @param options the file format and metadata layout options.
+   */
+  static void
+  write_surface(H5::H5File &file,
+                const Model &model,
+                const Surface &surface,
+                Precision precision,
+                const HDF5FileOptions &options) {
+
+    // Create a group for the surface.
+    H5::Group grp_surface(file.createGroup("/surface"));
+
+    // Write the triangles.
+    hsize_t dim_triangles[2];
+    dim_triangles[0] = surface.triangles.size();
+    dim_triangles[1] = 3;
+
+    H5::DataSpace dsp_triangles(2, dim_triangles);
+    H5::DataSet ds_triangles(
+        file.createDataSet(
+            "/surface/triangles",
+            index_type(index_bytes(surface.vertex_map.size())),
+            dsp_triangles
+        )
+    );
+
+    ds_triangles.write(surface.triangles.data(), H5::PredType::NATIVE_UINT64);
+
+    // Write the vertex map.
+    hsize_t dim_vertex_map[1];
+    dim_vertex_map[0] = surface.vertex_map.size();
+
+    H5::DataSpace dsp_vertex_map(1, dim_vertex_map);
+    H5::DataSet ds_vertex_map(
+        file.createDataSet(
+            "/surface/vertex_map",
+            H5::PredType::NATIVE_UINT64,
+            dsp_vertex_map
+        )
+    );
+
+    ds_vertex_map.write(surface.vertex_map.data(), H5::PredType::NATIVE_UINT64);
+
+    // Write the surface vertices and field slices.
+    hsize_t dim_vectors[2];
+    dim_vectors[0] = surface.vertex_map.size();
+    dim_vectors[1] = 3;
+
+    H5::DataSpace dsp_vectors(2, dim_vectors);
+
+    H5::DataSet ds_vertices(
+        file.createDataSet(
+            "/surface/vertices",
+            precision_type(precision),
+            dsp_vectors
+        )
+    );
+
+    ds_vertices.write(
+        surface.gather(model.mesh().vcl()).data(),
+        H5::PredType::NATIVE_DOUBLE
+    );
+
+    H5::Group grp_fields(options.create_group(file, "/surface/fields"));
+
+    size_t field_idx = 0;
+    for (const auto &field : model.field_list().fields()) {
+
+      std::stringstream ss_field;
+      ss_field << "/surface/fields/field" << field_idx;
+      H5::Group grp_field(file.createGroup(ss_field.str()));
+
+      H5::DataSet ds_field(
+          file.createDataSet(
+              ss_field.str() + "/vectors",
+              precision_type(precision),
+              dsp_vectors
+          )
+      );
+
+      ds_field.write(
+          surface.gather(field.vectors()).data(),
+          H5::PredType::NATIVE_DOUBLE
+      );
+
+      field_idx++;
+
+    }
+
+  }
+
+  static void
+  write_fields(H5::H5File &file, const Model &model, Precision precision, const HDF5FileOptions &options) {
 
     // Create a group for the fields.
-    H5::Group grp_mesh(file.createGroup("/fields"));
+    H5::Group grp_mesh(options.create_group(file, "/fields"));
 
     size_t field_idx = 0;
     for (const auto &field : model.field_list().fields()) {
-      write_field(file, field, field_idx);
+      write_field(file, field, field_idx, precision);
       field_idx++;
     }
 
   }
 
   static void
-  write_field(H5::H5File &file, const Field &field, size_t id) {
+  write_field(H5::H5File &file, const Field &field, size_t id, Precision precision) {
 
     // Create a group for the field.
     std::stringstream ss_field;
@@ -209,27 +596,8 @@ class MicromagFileWriter {
       );
     }
 
-    // Create a field id dataset in the mesh group.
-    hsize_t dim_field_idxs[2];
-    dim_field_idxs[0] = field.vectors().size();
-    dim_field_idxs[1] = 3;
-
-    std::stringstream ss_field_vectors;
-    ss_field_vectors << ss_field.str() << "/vectors";
-
-    H5::DataSpace dsp_field_idxs(2, dim_field_idxs);
-    H5::DataSet ds_field_idxs(
-        file.createDataSet(
-            ss_field_vectors.str(),
-            H5::PredType::NATIVE_DOUBLE,
-            dsp_field_idxs
-        )
-    );
-
-    ds_field_idxs.write(
-        field.vectors().data(),
-        H5::PredType::NATIVE_DOUBLE
-    );
+    // Write the field's vectors.
+    write_vectors(file, ss_field.str() + "/vectors", VectorView(field.vectors()), precision_type(precision));
 
   }
 
@@ -0,0 +1,192 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_WRITER_MICROMAG_SERIES_HPP_
+#define MFC_INCLUDE_WRITER_MICROMAG_SERIES_HPP_
+
+#include <algorithm>
+#include <exception>
+#include <span>
+#include <string>
+
+#include <H5Cpp.h>
+
+#include "aliases.hpp"
+#include "field.hpp"
+#include "hdf5_options.hpp"
+#include "mesh_hash.hpp"
+#include "model.hpp"
+#include "precision.hpp"
+#include "surface.hpp"
+#include "writer_micromag.hpp"
+
+/**
+ * Object that will be thrown on live micromagnetic model file writing
+ * exception.
+ */
+class MicromagSeriesWriterException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  MicromagSeriesWriterException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * Object that will write a micromagnetic model file that can be read while
+ * it is being written (HDF5 single-writer/multiple-reader mode), e.g. to
+ * watch a long conversion or a live run. The mesh (and surface) is written
+ * up front; the fields are then appended one at a time to the extendible
+ * [n_steps, n_vertices, 3] data set `/fields/series' (the layout of a
+ * stitched file, so XDMFFileWriter::write_series describes both), each
+ * flushed as soon as it is written, for MicromagSeriesReader to pick up.
+ * SWMR does not allow objects to be created once it has started, so the
+ * fields are not `/fields/field<i>' groups and carry no annotations.
+ */
+class MicromagSeriesWriter {
+
+ public:
+
+  // The path of the series data set.
+  static constexpr const char *SERIES = "/fields/series";
+
+  /**
+   * Create a file and write the mesh (the model's fields are not written,
+   * see `append').
+   * @param file_name the name of the file.
+   * @param model the model.
+   * @param precision the precision of the stored coordinates and fields.
+   * @param surface if not null, also write the model's surface.
+   * @param options the HDF5 file format & metadata options; the latest file
+   *                format is always used, since SWMR needs it.
+   */
+  MicromagSeriesWriter(const std::string &file_name,
+                       const Model &model,
+                       Precision precision = Precision::DOUBLE,
+                       const Surface *surface = nullptr,
+                       const HDF5FileOptions &options = HDF5FileOptions()) :
+      _file(file_name, H5F_ACC_TRUNC, options.create_properties(), access_properties(options)),
+      _n_vertices(model.mesh().vcl().size()) {
+
+    MicromagFileWriter::write_mesh_arrays(_file, model, precision, mesh_hash(model.mesh()));
+    if (surface != nullptr) {
+      MicromagFileWriter::write_surface(_file, model, *surface, precision, options);
+    }
+
+    H5::Group grp_fields(_file.createGroup("/fields"));
+
+    hsize_t dims[3] = {0, _n_vertices, 3};
+    hsize_t max_dims[3] = {H5S_UNLIMITED, _n_vertices, 3};
+    H5::DataSpace dsp_series(3, dims, max_dims);
+
+    // One chunk per step (split up for very large meshes).
+    hsize_t chunk_dims[3] = {1, std::clamp<hsize_t>(_n_vertices, 1, hsize_t{1} << 16), 3};
+    H5::DSetCreatPropList plist;
+    plist.setChunk(3, chunk_dims);
+
+    _series = _file.createDataSet(SERIES, precision_type(precision), dsp_series, plist);
+
+    grp_fields.close();
+
+    if (H5Fstart_swmr_write(_file.getId()) < 0) {
+      throw MicromagSeriesWriterException("Could not start SWMR writing of '" + file_name + "'.");
+    }
+
+  }
+
+  MicromagSeriesWriter(const MicromagSeriesWriter &) = delete;
+
+  MicromagSeriesWriter &operator=(const MicromagSeriesWriter &) = delete;
+
+  /**
+   * Append a field and flush it, so that readers can see it.
+   * @param vectors the field's vectors, one per vertex.
+   */
+  void
+  append(std::span<const fv> vectors) {
+
+    if (vectors.size() != _n_vertices) {
+      throw MicromagSeriesWriterException(
+          "Field has " + std::to_string(vectors.size()) + " vectors, mesh has "
+              + std::to_string(_n_vertices) + " vertices.");
+    }
+
+    hsize_t dims[3] = {_n_steps + 1, _n_vertices, 3};
+    _series.extend(dims);
+
+    H5::DataSpace file_space = _series.getSpace();
+    hsize_t start[3] = {_n_steps, 0, 0};
+    hsize_t count[3] = {1, _n_vertices, 3};
+    file_space.selectHyperslab(H5S_SELECT_SET, count, start);
+
+    hsize_t memory_dims[2] = {_n_vertices, 3};
+    H5::DataSpace memory_space(2, memory_dims);
+
+    _series.write(vectors.data(), H5::PredType::NATIVE_DOUBLE, memory_space, file_space);
+
+    if (H5Dflush(_series.getId()) < 0) {
+      throw MicromagSeriesWriterException("Could not flush field " + std::to_string(_n_steps) + ".");
+    }
+
+    _n_steps++;
+
+  }
+
+  /**
+   * Append a field and flush it, so that readers can see it.
+   * @param field the field.
+   */
+  void
+  append(const Field &field) { append(field.vectors()); }
+
+  /**
+   * Retrieve the number of fields appended so far.
+   */
+  [[nodiscard]] size_t
+  n_steps() const { return _n_steps; }
+
+ private:
+
+  H5::H5File _file;
+
+  H5::DataSet _series;
+
+  size_t _n_vertices;
+
+  size_t _n_steps = 0;
+
+  /**
+   * Retrieve the file access properties of a set of options, with the latest
+   * file format, which SWMR needs.
+   * @param options the HDF5 file format & metadata options.
+   */
+  static H5::FileAccPropList
+  access_properties(HDF5FileOptions options) {
+
+    options.latest_format = true;
+
+    return options.access_properties();
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_WRITER_MICROMAG_SERIES_HPP_
@@ -0,0 +1,437 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_WRITER_NUMPY_HPP_
+#define MFC_INCLUDE_WRITER_NUMPY_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <zlib.h>
+
+#include "aliases.hpp"
+#include "model.hpp"
+
+/**
+ * Object that will be thrown on NumPy `*.npy'/`*.npz' file writing exception.
+ */
+class NumpyFileWriterException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  NumpyFileWriterException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * Object that will write a model as NumPy arrays:
+ * - `vertices', float64 [n_verts, 3],
+ * - `elements', uint64 [n_elems, 4],
+ * - `submesh', uint64 [n_elems],
+ * - `fields', float64 [n_fields, n_verts, 3].
+ * The arrays are uncompressed and their data is 64-byte aligned in the file,
+ * so that `np.load(..., mmap_mode="r")' can map them without parsing or
+ * copying. They can be written as separate `*.npy' files or as members of a
+ * stored (uncompressed) `*.npz' archive. Each field is streamed directly from
+ * its vector list.
+ */
+class NumpyFileWriter {
+
+ public:
+
+  /**
+   * Default constructor.
+   */
+  NumpyFileWriter() = default;
+
+  /**
+   * Function that will write the arrays as `<prefix>_vertices.npy',
+   * `<prefix>_elements.npy', `<prefix>_submesh.npy' and `<prefix>_fields.npy'.
+   * @param prefix the prefix of the file names.
+   * @param model the model.
+   */
+  static void
+  write_npy(const std::string &prefix, const Model &model) {
+
+    for (const auto &array : arrays(model)) {
+
+      std::string file_name = prefix + "_" + array.name + ".npy";
+
+      std::ofstream fout(file_name, std::ios::binary);
+      if (!fout) {
+        throw NumpyFileWriterException("Could not open '" + file_name + "'.");
+      }
+
+      std::string header = npy_header(array);
+      fout.write(header.data(), (std::streamsize) header.size());
+      write_blocks(fout, array);
+
+    }
+
+  }
+
+  /**
+   * Function that will write the arrays as members `vertices.npy',
+   * `elements.npy', `submesh.npy' and `fields.npy' of a stored `*.npz' archive.
+   * @param file_name the name of the file.
+   * @param model the model.
+   */
+  static void
+  write_npz(const std::string &file_name, const Model &model) {
+
+    std::ofstream fout(file_name, std::ios::binary);
+    if (!fout) {
+      throw NumpyFileWriterException("Could not open '" + file_name + "'.");
+    }
+
+    std::vector<ZipEntry> entries;
+
+    for (const auto &array : arrays(model)) {
+
+      ZipEntry entry;
+      entry.name = array.name + ".npy";
+      entry.offset = (uint64_t) fout.tellp();
+
+      std::string header = npy_header(array);
+      entry.size = header.size() + array.n_bytes();
+      entry.crc = crc32(0L, reinterpret_cast<const Bytef *>(header.data()), (uInt) header.size());
+      for (const auto &block : array.blocks) {
+        entry.crc = crc32_block(entry.crc, block.first, block.second);
+      }
+
+      write_local_header(fout, entry);
+      fout.write(header.data(), (std::streamsize) header.size());
+      write_blocks(fout, array);
+
+      entries.push_back(entry);
+
+    }
+
+    write_central_directory(fout, entries);
+
+  }
+
+ private:
+
+  // Alignment of the array data in the output files.
+  static constexpr size_t ALIGNMENT = 64;
+
+  // Extra field header id used to pad local zip headers.
+  static constexpr uint16_t ZIP_PADDING_ID = 0xA1A1;
+
+  /**
+   * An array to write: its dtype, shape and the blocks of memory that hold its
+   * data (in order).
+   */
+  struct NpyArray {
+    std::string name;
+    std::string descr;
+    std::vector<size_t> shape;
+    std::vector<std::pair<const void *, size_t>> blocks;
+
+    [[nodiscard]] size_t
+    n_bytes() const {
+      size_t n = 0;
+      for (const auto &block : blocks) n += block.second;
+      return n;
+    }
+  };
+
+  /**
+   * A member of a zip archive.
+   */
+  struct ZipEntry {
+    std::string name;
+    uint64_t offset;
+    uint64_t size;
+    uLong crc;
+  };
+
+  /**
+   * Describe the model's data as a list of arrays, without copying anything.
+   * @param model the model.
+   * @return the arrays.
+   */
+  static std::vector<NpyArray>
+  arrays(const Model &model) {
+
+    const auto &vcl = model.mesh().vcl();
+    const auto &til = model.mesh().til();
+    const auto &sml = model.mesh().sml();
+    const auto &fields = model.field_list().fields();
+
+    std::string endian = std::endian::native == std::endian::little ? "<" : ">";
+
+    std::vector<NpyArray> result(4);
+
+    result[0] = {"vertices", endian + "f8", {vcl.size(), 3},
+                 {{vcl.data(), vcl.size() * sizeof(vert)}}};
+    result[1] = {"elements", endian + "u8", {til.size(), 4},
+                 {{til.data(), til.size() * sizeof(tet)}}};
+    result[2] = {"submesh", endian + "u8", {sml.size()},
+                 {{sml.data(), sml.size() * sizeof(size_t)}}};
+    result[3] = {"fields", endian + "f8", {fields.size(), vcl.size(), 3}, {}};
+
+    // A contiguous field list is a single block.
+    auto block = model.field_list().block();
+    if (!block.empty() && fields[0].size() == vcl.size()) {
+      result[3].blocks.emplace_back(block.data(), block.size() * sizeof(fv));
+      return result;
+    }
+
+    for (size_t i = 0; i < fields.size(); ++i) {
+      const auto &vectors = fields[i].vectors();
+      if (vectors.size() != vcl.size()) {
+        std::stringstream ss;
+        ss << "Field " << i << " does not have one vector per vertex.";
+        throw NumpyFileWriterException(ss.str());
+      }
+      result[3].blocks.emplace_back(vectors.data(), vectors.size() * sizeof(fv));
+    }
+
+    return result;
+
+  }
+
+  /**
+   * Create a version 1.0 `*.npy' header, padded so that the array data that
+   * follows it is aligned.
+   * @param array the array.
+   * @return the header.
+   */
+  static std::string
+  npy_header(const NpyArray &array) {
+
+    std::stringstream ss_dict;
+    ss_dict << "{'descr': '" << array.descr
+            << "', 'fortran_order': False, 'shape': (";
+    for (size_t i = 0; i < array.shape.size(); ++i) {
+      ss_dict << array.shape[i] << (array.shape.size() == 1 || i + 1 < array.shape.size() ? "," : "");
+      if (i + 1 < array.shape.size()) ss_dict << " ";
+    }
+    ss_dict << "), }";
+
+    std::string dict = ss_dict.str();
+
+    // Magic (6) + version (2) + header length (2) + dict + padding + '\n'.
+    size_t length = 10 + dict.size() + 1;
+    size_t padding = (ALIGNMENT - length % ALIGNMENT) % ALIGNMENT;
+    dict.append(padding, ' ');
+    dict.push_back('\n');
+
+    if (dict.size() > UINT16_MAX) {
+      throw NumpyFileWriterException("NumPy header is too long.");
+    }
+
+    std::string header("\x93NUMPY\x01\x00", 8);
+    header.push_back((char) (dict.size() & 0xff));
+    header.push_back((char) ((dict.size() >> 8) & 0xff));
+    header.append(dict);
+
+    return header;
+
+  }
+
+  /**
+   * Write the data blocks of an array.
+   * @param fout the output stream.
+   * @param array the array.
+   */
+  static void
+  write_blocks(std::ofstream &fout, const NpyArray &array) {
+
+    for (const auto &block : array.blocks) {
+      fout.write(static_cast<const char *>(block.first), (std::streamsize) block.second);
+    }
+
+    if (!fout) {
+      throw NumpyFileWriterException("Failed to write '" + array.name + "'.");
+    }
+
+  }
+
+  /**
+   * Update a CRC-32 with a block of memory of any size.
+   * @param crc the current CRC.
+   * @param data the block.
+   * @param n_bytes the size of the block.
+   * @return the updated CRC.
+   */
+  static uLong
+  crc32_block(uLong crc, const void *data, size_t n_bytes) {
+
+    const auto *p = static_cast<const Bytef *>(data);
+
+    while (n_bytes > 0) {
+      auto n = (uInt) std::min<size_t>(n_bytes, 1u << 30);
+      crc = crc32(crc, p, n);
+      p += n;
+      n_bytes -= n;
+    }
+
+    return crc;
+
+  }
+
+  /**
+   * Append a little endian integer to a byte string.
+   */
+  template<typename T>
+  static void
+  put(std::string &bytes, T value) {
+
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      bytes.push_back((char) ((uint64_t) value >> (8 * i) & 0xff));
+    }
+
+  }
+
+  /**
+   * Write the local file header of a zip entry. The sizes are always given in
+   * a ZIP64 extra field and the header is padded so that the member's data
+   * starts on an aligned offset.
+   * @param fout the output stream.
+   * @param entry the entry.
+   */
+  static void
+  write_local_header(std::ofstream &fout, const ZipEntry &entry) {
+
+    std::string extra;
+    put<uint16_t>(extra, 0x0001);
+    put<uint16_t>(extra, 16);
+    put<uint64_t>(extra, entry.size);
+    put<uint64_t>(extra, entry.size);
+
+    size_t length = entry.offset + 30 + entry.name.size() + extra.size();
+    size_t padding = (ALIGNMENT - length % ALIGNMENT) % ALIGNMENT;
+    if (padding > 0 && padding < 4) padding += ALIGNMENT;
+    if (padding > 0) {
+      put<uint16_t>(extra, ZIP_PADDING_ID);
+      put<uint16_t>(extra, (uint16_t) (padding - 4));
+      extra.append(padding - 4, '\0');
+    }
+
+    std::string header;
+    put<uint32_t>(header, 0x04034b50);
+    put<uint16_t>(header, 45);
+    put<uint16_t>(header, 0);
+    put<uint16_t>(header, 0);
+    put<uint16_t>(header, 0);
+    put<uint16_t>(header, 0x21);
+    put<uint32_t>(header, (uint32_t) entry.crc);
+    put<uint32_t>(header, 0xffffffff);
+    put<uint32_t>(header, 0xffffffff);
+    put<uint16_t>(header, (uint16_t) entry.name.size());
+    put<uint16_t>(header, (uint16_t) extra.size());
+    header.append(entry.name);
+    header.append(extra);
+
+    fout.write(header.data(), (std::streamsize) header.size());
+
+  }
+
+  /**
+   * Write the central directory and the (ZIP64) end of central directory
+   * records.
+   * @param fout the output stream.
+   * @param entries the entries of the archive.
+   */
+  static void
+  write_central_directory(std::ofstream &fout,
+                          const std::vector<ZipEntry> &entries) {
+
+    auto cd_offset = (uint64_t) fout.tellp();
+
+    std::string cd;
+    for (const auto &entry : entries) {
+      put<uint32_t>(cd, 0x02014b50);
+      put<uint16_t>(cd, 45);
+      put<uint16_t>(cd, 45);
+      put<uint16_t>(cd, 0);
+      put<uint16_t>(cd, 0);
+      put<uint16_t>(cd, 0);
+      put<uint16_t>(cd, 0x21);
+      put<uint32_t>(cd, (uint32_t) entry.crc);
+      put<uint32_t>(cd, 0xffffffff);
+      put<uint32_t>(cd, 0xffffffff);
+      put<uint16_t>(cd, (uint16_t) entry.name.size());
+      put<uint16_t>(cd, 28);
+      put<uint16_t>(cd, 0);
+      put<uint16_t>(cd, 0);
+      put<uint16_t>(cd, 0);
+      put<uint32_t>(cd, 0);
+      put<uint32_t>(cd, 0xffffffff);
+      cd.append(entry.name);
+      put<uint16_t>(cd, 0x0001);
+      put<uint16_t>(cd, 24);
+      put<uint64_t>(cd, entry.size);
+      put<uint64_t>(cd, entry.size);
+      put<uint64_t>(cd, entry.offset);
+    }
+
+    uint64_t eocd64_offset = cd_offset + cd.size();
+
+    // ZIP64 end of central directory record.
+    put<uint32_t>(cd, 0x06064b50);
+    put<uint64_t>(cd, 44);
+    put<uint16_t>(cd, 45);
+    put<uint16_t>(cd, 45);
+    put<uint32_t>(cd, 0);
+    put<uint32_t>(cd, 0);
+    put<uint64_t>(cd, entries.size());
+    put<uint64_t>(cd, entries.size());
+    put<uint64_t>(cd, eocd64_offset - cd_offset);
+    put<uint64_t>(cd, cd_offset);
+
+    // ZIP64 end of central directory locator.
+    put<uint32_t>(cd, 0x07064b50);
+    put<uint32_t>(cd, 0);
+    put<uint64_t>(cd, eocd64_offset);
+    put<uint32_t>(cd, 1);
+
+    // End of central directory record.
+    put<uint32_t>(cd, 0x06054b50);
+    put<uint16_t>(cd, 0);
+    put<uint16_t>(cd, 0);
+    put<uint16_t>(cd, (uint16_t) entries.size());
+    put<uint16_t>(cd, (uint16_t) entries.size());
+    put<uint32_t>(cd, 0xffffffff);
+    put<uint32_t>(cd, 0xffffffff);
+    put<uint16_t>(cd, 0);
+
+    fout.write(cd.data(), (std::streamsize) cd.size());
+
+    if (!fout) {
+      throw NumpyFileWriterException("Failed to write the zip directory.");
+    }
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_WRITER_NUMPY_HPP_
@@ -0,0 +1,137 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_WRITER_OVF_HPP_
+#define MFC_INCLUDE_WRITER_OVF_HPP_
+
+#include <bit>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <sstream>
+
+#include "aliases.hpp"
+#include "resampler.hpp"
+
+/**
+ * Object that will be thrown on OOMMF `*.ovf' file writing exception.
+ */
+class OVFFileWriterException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  OVFFileWriterException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * Object that will write a vector field on a regular grid as an OOMMF OVF 2.0
+ * file with `Binary 8' (little endian double) data.
+ */
+class OVFFileWriter {
+
+ public:
+
+  /**
+   * Default constructor.
+   */
+  OVFFileWriter() = default;
+
+  /**
+   * Function that will write a file.
+   * @param file_name the name of the file.
+   * @param grid the grid.
+   * @param values the vectors, one per grid cell with x fastest.
+   * @param title the title of the segment.
+   * @param mesh_unit the unit of the grid coordinates.
+   */
+  static void
+  write(const std::string &file_name,
+        const RegularGrid &grid,
+        const fv_list &values,
+        const std::string &title = "m",
+        const std::string &mesh_unit = "um") {
+
+    static_assert(std::endian::native == std::endian::little,
+                  "OVF binary output requires a little endian host.");
+
+    if (values.size() != grid.size()) {
+      throw OVFFileWriterException("No. of values does not match the grid.");
+    }
+
+    std::ofstream fout(file_name, std::ios::binary);
+    if (!fout) {
+      throw OVFFileWriterException("Could not open '" + file_name + "'.");
+    }
+
+    std::stringstream ss;
+    ss << std::setprecision(17);
+    ss << "# OOMMF OVF 2.0\n"
+       << "# Segment count: 1\n"
+       << "# Begin: Segment\n"
+       << "# Begin: Header\n"
+       << "# Title: " << title << "\n"
+       << "# meshtype: rectangular\n"
+       << "# meshunit: " << mesh_unit << "\n"
+       << "# xmin: " << grid.min[0] << "\n"
+       << "# ymin: " << grid.min[1] << "\n"
+       << "# zmin: " << grid.min[2] << "\n"
+       << "# xmax: " << grid.min[0] + (double) grid.n[0] * grid.step[0] << "\n"
+       << "# ymax: " << grid.min[1] + (double) grid.n[1] * grid.step[1] << "\n"
+       << "# zmax: " << grid.min[2] + (double) grid.n[2] * grid.step[2] << "\n"
+       << "# valuedim: 3\n"
+       << "# valuelabels: " << title << "_x " << title << "_y " << title << "_z\n"
+       << "# valueunits: 1 1 1\n"
+       << "# xbase: " << grid.min[0] + 0.5 * grid.step[0] << "\n"
+       << "# ybase: " << grid.min[1] + 0.5 * grid.step[1] << "\n"
+       << "# zbase: " << grid.min[2] + 0.5 * grid.step[2] << "\n"
+       << "# xnodes: " << grid.n[0] << "\n"
+       << "# ynodes: " << grid.n[1] << "\n"
+       << "# znodes: " << grid.n[2] << "\n"
+       << "# xstepsize: " << grid.step[0] << "\n"
+       << "# ystepsize: " << grid.step[1] << "\n"
+       << "# zstepsize: " << grid.step[2] << "\n"
+       << "# End: Header\n"
+       << "# Begin: Data Binary 8\n";
+
+    std::string header = ss.str();
+    fout.write(header.data(), (std::streamsize) header.size());
+
+    // The check value that identifies the byte order and precision.
+    double check = 123456789012345.0;
+    fout.write(reinterpret_cast<const char *>(&check), sizeof(check));
+
+    fout.write(reinterpret_cast<const char *>(values.data()),
+               (std::streamsize) (values.size() * sizeof(fv)));
+
+    fout << "\n# End: Data Binary 8\n"
+         << "# End: Segment\n";
+
+    if (!fout) {
+      throw OVFFileWriterException("Failed to write '" + file_name + "'.");
+    }
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_WRITER_OVF_HPP_
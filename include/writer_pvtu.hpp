@@ -0,0 +1,458 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_WRITER_PVTU_HPP_
+#define MFC_INCLUDE_WRITER_PVTU_HPP_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include <rapidxml_ext.hpp>
+#include <zlib.h>
+
+#include "aliases.hpp"
+#include "model.hpp"
+#include "parallel.hpp"
+
+/**
+ * Object that will be thrown on partitioned VTU file writing exception.
+ */
+class PVTUFileWriterException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  PVTUFileWriterException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * Object that will write a model as a set of VTK XML unstructured grid pieces
+ * (`*.vtu') and a parallel index (`*.pvtu') so that ParaView's parallel
+ * readers can load the pieces independently.
+ *
+ * The elements are split in to contiguous ranges, each piece holds its
+ * elements, the vertices they reference (renumbered locally), the submesh
+ * indices as cell data `sid' and every field as point data `field<i>'. The
+ * pieces are written concurrently, each as raw binary appended data which may
+ * optionally be zlib compressed.
+ */
+class PVTUFileWriter {
+
+ public:
+
+  /**
+   * Default constructor.
+   */
+  PVTUFileWriter() = default;
+
+  /**
+   * Function that will write a file. The pieces are written next to the
+   * index file as `<stem>_<i>.vtu'.
+   * @param file_name the name of the `*.pvtu' index file.
+   * @param model the model.
+   * @param n_pieces the number of pieces (0 selects the number of hardware
+   *                 threads).
+   * @param compress true if the appended data should be zlib compressed.
+   */
+  static void
+  write(const std::string &file_name,
+        const Model &model,
+        size_t n_pieces = 0,
+        bool compress = false) {
+
+    size_t n_elems = model.mesh().til().size();
+
+    if (n_pieces == 0) n_pieces = n_worker_threads();
+    n_pieces = std::max<size_t>(1, std::min(n_pieces, n_elems));
+
+    std::filesystem::path path(file_name);
+    std::vector<std::string> piece_names(n_pieces);
+    for (size_t i = 0; i < n_pieces; ++i) {
+      std::stringstream ss;
+      ss << path.stem().string() << "_" << i << ".vtu";
+      piece_names[i] = ss.str();
+    }
+
+    // Write the pieces, one per thread.
+    parallel_for(n_pieces, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        size_t elem_begin = i * n_elems / n_pieces;
+        size_t elem_end = (i + 1) * n_elems / n_pieces;
+        write_piece(
+            (path.parent_path() / piece_names[i]).string(),
+            model,
+            elem_begin,
+            elem_end,
+            compress
+        );
+      }
+    }, n_pieces);
+
+    write_index(file_name, model, piece_names);
+
+  }
+
+ private:
+
+  // VTK cell type of a linear tetrahedron.
+  static constexpr uint8_t VTK_TETRA = 10;
+
+  // Uncompressed size of a zlib compressed block.
+  static constexpr size_t COMPRESSION_BLOCK_SIZE = 32768;
+
+  /**
+   * Retrieve the byte order of this machine, as VTK names it.
+   * @return the byte order string.
+   */
+  static const char *
+  byte_order() {
+
+    return std::endian::native == std::endian::little
+           ? "LittleEndian"
+           : "BigEndian";
+
+  }
+
+  /**
+   * Accumulates the appended data section of a piece, along with the offset
+   * of each array in to that section.
+   */
+  class AppendedData {
+
+   public:
+
+    explicit AppendedData(bool compress) : _compress(compress) {}
+
+    /**
+     * Append an array.
+     * @param data the array's bytes.
+     * @param n_bytes the number of bytes.
+     * @return the offset of the array in the appended data.
+     */
+    size_t
+    append(const void *data, size_t n_bytes) {
+
+      size_t offset = _bytes.size();
+
+      if (_compress) {
+        append_compressed(static_cast<const uint8_t *>(data), n_bytes);
+      } else {
+        auto header = (uint64_t) n_bytes;
+        append_raw(&header, sizeof(header));
+        append_raw(data, n_bytes);
+      }
+
+      return offset;
+
+    }
+
+    [[nodiscard]] const std::vector<char> &
+    bytes() const { return _bytes; }
+
+   private:
+
+    bool _compress;
+
+    std::vector<char> _bytes;
+
+    void
+    append_raw(const void *data, size_t n_bytes) {
+
+      const char *p = static_cast<const char *>(data);
+      _bytes.insert(_bytes.end(), p, p + n_bytes);
+
+    }
+
+    /**
+     * Append an array in the vtkZLibDataCompressor layout: a header of
+     * [n_blocks, block_size, last_block_size, compressed_size_0, ...]
+     * followed by the compressed blocks.
+     */
+    void
+    append_compressed(const uint8_t *data, size_t n_bytes) {
+
+      size_t n_blocks = (n_bytes + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+      size_t last_block_size = n_bytes - (n_blocks > 0 ? (n_blocks - 1) * COMPRESSION_BLOCK_SIZE : 0);
+
+      std::vector<uint64_t> header(3 + n_blocks);
+      header[0] = n_blocks;
+      header[1] = COMPRESSION_BLOCK_SIZE;
+      header[2] = n_blocks > 0 ? last_block_size : 0;
+
+      size_t header_offset = _bytes.size();
+      append_raw(header.data(), header.size() * sizeof(uint64_t));
+
+      std::vector<Bytef> block(compressBound(COMPRESSION_BLOCK_SIZE));
+      for (size_t b = 0; b < n_blocks; ++b) {
+
+        size_t size = b + 1 < n_blocks ? COMPRESSION_BLOCK_SIZE : last_block_size;
+        uLongf compressed_size = block.size();
+
+        if (compress2(block.data(), &compressed_size,
+                      data + b * COMPRESSION_BLOCK_SIZE, size,
+                      Z_DEFAULT_COMPRESSION) != Z_OK) {
+          throw PVTUFileWriterException("Failed to compress appended data.");
+        }
+
+        header[3 + b] = compressed_size;
+        append_raw(block.data(), compressed_size);
+
+      }
+
+      std::copy_n(reinterpret_cast<const char *>(header.data()),
+                  header.size() * sizeof(uint64_t),
+                  _bytes.begin() + (std::ptrdiff_t) header_offset);
+
+    }
+
+  };
+
+  /**
+   * Write a single piece holding the elements [elem_begin, elem_end).
+   * @param file_name the name of the `*.vtu' file.
+   * @param model the model.
+   * @param elem_begin the first element of the piece.
+   * @param elem_end one past the last element of the piece.
+   * @param compress true if the appended data should be compressed.
+   */
+  static void
+  write_piece(const std::string &file_name,
+              const Model &model,
+              size_t elem_begin,
+              size_t elem_end,
+              bool compress) {
+
+    const auto &vcl = model.mesh().vcl();
+    const auto &til = model.mesh().til();
+    const auto &sml = model.mesh().sml();
+    const auto &fields = model.field_list().fields();
+
+    size_t n_elems = elem_end - elem_begin;
+
+    // The (sorted) global indices of the vertices used by this piece.
+    std::vector<size_t> global_idxs;
+    global_idxs.reserve(4 * n_elems);
+    for (size_t e = elem_begin; e < elem_end; ++e) {
+      global_idxs.insert(global_idxs.end(), til[e].begin(), til[e].end());
+    }
+    std::sort(global_idxs.begin(), global_idxs.end());
+    global_idxs.erase(std::unique(global_idxs.begin(), global_idxs.end()),
+                      global_idxs.end());
+
+    size_t n_verts = global_idxs.size();
+
+    // Local connectivity.
+    std::vector<int64_t> connectivity(4 * n_elems);
+    for (size_t e = 0; e < n_elems; ++e) {
+      for (size_t j = 0; j < 4; ++j) {
+        size_t v = til[elem_begin + e][j];
+        connectivity[4 * e + j] = (int64_t) (
+            std::lower_bound(global_idxs.begin(), global_idxs.end(), v)
+                - global_idxs.begin());
+      }
+    }
+
+    std::vector<int64_t> offsets(n_elems);
+    for (size_t e = 0; e < n_elems; ++e) offsets[e] = (int64_t) (4 * (e + 1));
+
+    std::vector<uint8_t> types(n_elems, VTK_TETRA);
+
+    std::vector<int64_t> sids(n_elems);
+    for (size_t e = 0; e < n_elems; ++e) sids[e] = (int64_t) sml[elem_begin + e];
+
+    AppendedData appended(compress);
+
+    // Gather a per-vertex array of triples from a global list.
+    std::vector<std::array<double, 3>> gathered(n_verts);
+    auto gather = [&](std::span<const std::array<double, 3>> src) {
+      for (size_t i = 0; i < n_verts; ++i) gathered[i] = src[global_idxs[i]];
+      return appended.append(gathered.data(), n_verts * sizeof(gathered[0]));
+    };
+
+    size_t off_points = gather(vcl);
+    size_t off_connectivity = appended.append(
+        connectivity.data(), connectivity.size() * sizeof(int64_t));
+    size_t off_offsets = appended.append(
+        offsets.data(), offsets.size() * sizeof(int64_t));
+    size_t off_types = appended.append(types.data(), types.size());
+    size_t off_sids = appended.append(sids.data(), sids.size() * sizeof(int64_t));
+
+    std::vector<size_t> off_fields(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+      if (fields[i].vectors().size() != vcl.size()) {
+        std::stringstream ss;
+        ss << "Field " << i << " does not have one vector per vertex.";
+        throw PVTUFileWriterException(ss.str());
+      }
+      off_fields[i] = gather(fields[i].vectors());
+    }
+
+    std::ofstream fout(file_name, std::ios::binary);
+    if (!fout) {
+      throw PVTUFileWriterException("Could not open '" + file_name + "'.");
+    }
+
+    fout << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+         << byte_order() << "\" header_type=\"UInt64\"";
+    if (compress) fout << " compressor=\"vtkZLibDataCompressor\"";
+    fout << ">\n"
+         << "  <UnstructuredGrid>\n"
+         << "    <Piece NumberOfPoints=\"" << n_verts
+         << "\" NumberOfCells=\"" << n_elems << "\">\n";
+
+    fout << "      <PointData";
+    if (!fields.empty()) fout << " Vectors=\"field0\"";
+    fout << ">\n";
+    for (size_t i = 0; i < fields.size(); ++i) {
+      fout << "        <DataArray type=\"Float64\" Name=\"field" << i
+           << "\" NumberOfComponents=\"3\" format=\"appended\" offset=\""
+           << off_fields[i] << "\"/>\n";
+    }
+    fout << "      </PointData>\n"
+         << "      <CellData Scalars=\"sid\">\n"
+         << "        <DataArray type=\"Int64\" Name=\"sid\" format=\"appended\" offset=\""
+         << off_sids << "\"/>\n"
+         << "      </CellData>\n"
+         << "      <Points>\n"
+         << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\""
+         << off_points << "\"/>\n"
+         << "      </Points>\n"
+         << "      <Cells>\n"
+         << "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\""
+         << off_connectivity << "\"/>\n"
+         << "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\""
+         << off_offsets << "\"/>\n"
+         << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\""
+         << off_types << "\"/>\n"
+         << "      </Cells>\n"
+         << "    </Piece>\n"
+         << "  </UnstructuredGrid>\n"
+         << "  <AppendedData encoding=\"raw\">\n"
+         << "   _";
+    fout.write(appended.bytes().data(), (std::streamsize) appended.bytes().size());
+    fout << "\n  </AppendedData>\n"
+         << "</VTKFile>\n";
+
+  }
+
+  /**
+   * Write the `*.pvtu' index file.
+   * @param file_name the name of the index file.
+   * @param model the model.
+   * @param piece_names the (relative) file names of the pieces.
+   */
+  static void
+  write_index(const std::string &file_name,
+              const Model &model,
+              const std::vector<std::string> &piece_names) {
+
+    using namespace rapidxml;
+
+    size_t n_fields = model.field_list().n_fields();
+    std::vector<std::string> field_names(n_fields);
+    for (size_t i = 0; i < n_fields; ++i) {
+      field_names[i] = "field" + std::to_string(i);
+    }
+
+    xml_document<> doc;
+
+    // Create a declaration node.
+    xml_node<> *decl = doc.allocate_node(node_declaration);
+    decl->append_attribute(doc.allocate_attribute("version", "1.0"));
+    doc.append_node(decl);
+
+    // Create /VTKFile node.
+    xml_node<> *vtk_file = doc.allocate_node(node_element, "VTKFile");
+    vtk_file->append_attribute(doc.allocate_attribute("type", "PUnstructuredGrid"));
+    vtk_file->append_attribute(doc.allocate_attribute("version", "1.0"));
+    vtk_file->append_attribute(doc.allocate_attribute("byte_order", byte_order()));
+    vtk_file->append_attribute(doc.allocate_attribute("header_type", "UInt64"));
+    doc.append_node(vtk_file);
+
+    // Create /VTKFile/PUnstructuredGrid node.
+    xml_node<> *grid = doc.allocate_node(node_element, "PUnstructuredGrid");
+    grid->append_attribute(doc.allocate_attribute("GhostLevel", "0"));
+    vtk_file->append_node(grid);
+
+    // Create /VTKFile/PUnstructuredGrid/PPointData node.
+    xml_node<> *point_data = doc.allocate_node(node_element, "PPointData");
+    if (n_fields > 0) {
+      point_data->append_attribute(doc.allocate_attribute("Vectors", field_names[0].c_str()));
+    }
+    grid->append_node(point_data);
+
+    for (const auto &field_name : field_names) {
+      xml_node<> *array = doc.allocate_node(node_element, "PDataArray");
+      array->append_attribute(doc.allocate_attribute("type", "Float64"));
+      array->append_attribute(doc.allocate_attribute("Name", field_name.c_str()));
+      array->append_attribute(doc.allocate_attribute("NumberOfComponents", "3"));
+      point_data->append_node(array);
+    }
+
+    // Create /VTKFile/PUnstructuredGrid/PCellData node.
+    xml_node<> *cell_data = doc.allocate_node(node_element, "PCellData");
+    cell_data->append_attribute(doc.allocate_attribute("Scalars", "sid"));
+    grid->append_node(cell_data);
+
+    xml_node<> *sid_array = doc.allocate_node(node_element, "PDataArray");
+    sid_array->append_attribute(doc.allocate_attribute("type", "Int64"));
+    sid_array->append_attribute(doc.allocate_attribute("Name", "sid"));
+    cell_data->append_node(sid_array);
+
+    // Create /VTKFile/PUnstructuredGrid/PPoints node.
+    xml_node<> *points = doc.allocate_node(node_element, "PPoints");
+    grid->append_node(points);
+
+    xml_node<> *points_array = doc.allocate_node(node_element, "PDataArray");
+    points_array->append_attribute(doc.allocate_attribute("type", "Float64"));
+    points_array->append_attribute(doc.allocate_attribute("NumberOfComponents", "3"));
+    points->append_node(points_array);
+
+    // Create /VTKFile/PUnstructuredGrid/Piece nodes.
+    for (const auto &piece_name : piece_names) {
+      xml_node<> *piece = doc.allocate_node(node_element, "Piece");
+      piece->append_attribute(doc.allocate_attribute("Source", piece_name.c_str()));
+      grid->append_node(piece);
+    }
+
+    // Save the XML document to a file
+    std::ofstream file(file_name);
+    file << doc;
+    file.close();
+
+    // Clean up the memory
+    doc.clear();
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_WRITER_PVTU_HPP_
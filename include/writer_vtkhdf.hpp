@@ -0,0 +1,407 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#ifndef MFC_INCLUDE_WRITER_VTKHDF_HPP_
+#define MFC_INCLUDE_WRITER_VTKHDF_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include <H5Cpp.h>
+
+#include "aliases.hpp"
+#include "model.hpp"
+
+/**
+ * Object that will be thrown on VTKHDF file writing exception.
+ */
+class VTKHDFFileWriterException : std::exception {
+
+ public:
+
+  /**
+   * Constructor, will create a new exception object.
+   * @param message the exception message.
+   */
+  explicit
+  VTKHDFFileWriterException(std::string message) :
+      _message(std::move(message)) {}
+
+  [[nodiscard]] const char *
+  what() const noexcept override {
+
+    return _message.c_str();
+
+  }
+
+ private:
+
+  std::string _message;
+
+};
+
+/**
+ * Object that will write a model as a VTKHDF (version 2.0) UnstructuredGrid
+ * that ParaView can read directly.
+ *
+ * The mesh is written once: every time step points at the same `Points',
+ * `Connectivity', `Offsets' and `Types' through zero geometry offsets in the
+ * `/VTKHDF/Steps' group. Each field of the model is a time step of the point
+ * data array `m', and the submesh indices are written as the cell data array
+ * `sid'. Bulk datasets are chunked and deflate compressed.
+ */
+class VTKHDFFileWriter {
+
+ public:
+
+  /**
+   * Default constructor.
+   */
+  VTKHDFFileWriter() = default;
+
+  /**
+   * Function that will write a file.
+   * @param file_name the name of the file.
+   * @param model the model.
+   * @param compression_level the deflate level (0 disables compression).
+   */
+  static void
+  write(const std::string &file_name,
+        const Model &model,
+        unsigned compression_level = 4) {
+
+    if (compression_level > 9) {
+      throw VTKHDFFileWriterException("Compression level must be 0 - 9.");
+    }
+
+    H5::H5File file(file_name, H5F_ACC_TRUNC);
+
+    H5::Group grp_root(file.createGroup("/VTKHDF"));
+    write_root_attributes(grp_root);
+
+    write_geometry(file, model, compression_level);
+    write_point_data(file, model, compression_level);
+    write_cell_data(file, model, compression_level);
+
+    if (model.field_list().n_fields() > 0) write_steps(file, model);
+
+  }
+
+ private:
+
+  // VTK cell type of a linear tetrahedron.
+  static constexpr uint8_t VTK_TETRA = 10;
+
+  // Number of rows per chunk for bulk datasets.
+  static constexpr hsize_t CHUNK_ROWS = 65536;
+
+  /**
+   * Write the `Version' and `Type' attributes of the `/VTKHDF' group.
+   * @param grp_root the `/VTKHDF' group.
+   */
+  static void
+  write_root_attributes(H5::Group &grp_root) {
+
+    int version[2] = {2, 0};
+    hsize_t dim_version[1] = {2};
+    H5::DataSpace dsp_version(1, dim_version);
+    H5::Attribute att_version = grp_root.createAttribute(
+        "Version",
+        H5::PredType::NATIVE_INT,
+        dsp_version
+    );
+    att_version.write(H5::PredType::NATIVE_INT, version);
+
+    std::string type = "UnstructuredGrid";
+    H5::StrType str_type(H5::PredType::C_S1, type.size());
+    str_type.setStrpad(H5T_STR_NULLPAD);
+    H5::DataSpace dsp_type(H5S_SCALAR);
+    H5::Attribute att_type = grp_root.createAttribute(
+        "Type",
+        str_type,
+        dsp_type
+    );
+    att_type.write(str_type, type.data());
+
+  }
+
+  /**
+   * Create a dataset creation property list with chunking and compression.
+   * @param rank the rank of the dataset.
+   * @param dims the dimensions of the dataset.
+   * @param compression_level the deflate level (0 disables compression).
+   * @return the property list.
+   */
+  static H5::DSetCreatPropList
+  chunked(int rank, const hsize_t *dims, unsigned compression_level) {
+
+    H5::DSetCreatPropList plist;
+
+    if (dims[0] == 0) return plist;
+
+    hsize_t dim_chunk[2];
+    dim_chunk[0] = std::min(dims[0], CHUNK_ROWS);
+    if (rank > 1) dim_chunk[1] = dims[1];
+
+    plist.setChunk(rank, dim_chunk);
+    if (compression_level > 0) {
+      plist.setShuffle();
+      plist.setDeflate(compression_level);
+    }
+
+    return plist;
+
+  }
+
+  /**
+   * Write a one dimensional 64-bit integer dataset.
+   * @param loc the group that will hold the dataset.
+   * @param name the name of the dataset.
+   * @param data the values.
+   * @param plist the dataset creation property list.
+   */
+  static void
+  write_int64(H5::Group &loc,
+              const std::string &name,
+              const std::vector<int64_t> &data,
+              const H5::DSetCreatPropList &plist = H5::DSetCreatPropList()) {
+
+    hsize_t dim[1] = {data.size()};
+    H5::DataSpace dsp(1, dim);
+    H5::DataSet ds(loc.createDataSet(name, H5::PredType::NATIVE_INT64, dsp, plist));
+    if (!data.empty()) ds.write(data.data(), H5::PredType::NATIVE_INT64);
+
+  }
+
+  /**
+   * Write the points and the tetrahedral cells, these are shared by all steps.
+   * @param file the HDF5 file handle.
+   * @param model the model.
+   * @param compression_level the deflate level.
+   */
+  static void
+  write_geometry(H5::H5File &file,
+                 const Model &model,
+                 unsigned compression_level) {
+
+    const auto &vcl = model.mesh().vcl();
+    const auto &til = model.mesh().til();
+
+    H5::Group grp_root = file.openGroup("/VTKHDF");
+
+    // There is a single partition.
+    write_int64(grp_root, "NumberOfPoints", {(int64_t) vcl.size()});
+    write_int64(grp_root, "NumberOfCells", {(int64_t) til.size()});
+    write_int64(grp_root, "NumberOfConnectivityIds", {(int64_t) (4 * til.size())});
+
+    // Points.
+    hsize_t dim_points[2] = {vcl.size(), 3};
+    H5::DataSpace dsp_points(2, dim_points);
+    H5::DataSet ds_points(
+        grp_root.createDataSet(
+            "Points",
+            H5::PredType::NATIVE_DOUBLE,
+            dsp_points,
+            chunked(2, dim_points, compression_level)
+        )
+    );
+    ds_points.write(vcl.data(), H5::PredType::NATIVE_DOUBLE);
+
+    // Connectivity, the tetrahedra are already stored contiguously.
+    hsize_t dim_connectivity[1] = {4 * til.size()};
+    H5::DataSpace dsp_connectivity(1, dim_connectivity);
+    H5::DataSet ds_connectivity(
+        grp_root.createDataSet(
+            "Connectivity",
+            H5::PredType::NATIVE_INT64,
+            dsp_connectivity,
+            chunked(1, dim_connectivity, compression_level)
+        )
+    );
+    ds_connectivity.write(til.data(), H5::PredType::NATIVE_UINT64);
+
+    // Offsets.
+    std::vector<int64_t> offsets(til.size() + 1);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+      offsets[i] = (int64_t) (4 * i);
+    }
+    hsize_t dim_offsets[1] = {offsets.size()};
+    write_int64(grp_root, "Offsets", offsets,
+                chunked(1, dim_offsets, compression_level));
+
+    // Types.
+    std::vector<uint8_t> types(til.size(), VTK_TETRA);
+    hsize_t dim_types[1] = {types.size()};
+    H5::DataSpace dsp_types(1, dim_types);
+    H5::DataSet ds_types(
+        grp_root.createDataSet(
+            "Types",
+            H5::PredType::NATIVE_UINT8,
+            dsp_types,
+            chunked(1, dim_types, compression_level)
+        )
+    );
+    ds_types.write(types.data(), H5::PredType::NATIVE_UINT8);
+
+  }
+
+  /**
+   * Write the fields as consecutive steps of the point data array `m'.
+   * @param file the HDF5 file handle.
+   * @param model the model.
+   * @param compression_level the deflate level.
+   */
+  static void
+  write_point_data(H5::H5File &file,
+                   const Model &model,
+                   unsigned compression_level) {
+
+    H5::Group grp_point_data(file.createGroup("/VTKHDF/PointData"));
+
+    const auto &fields = model.field_list().fields();
+    if (fields.empty()) return;
+
+    hsize_t n_verts = model.mesh().vcl().size();
+
+    hsize_t dim_m[2] = {fields.size() * n_verts, 3};
+    H5::DataSpace dsp_m(2, dim_m);
+    H5::DataSet ds_m(
+        grp_point_data.createDataSet(
+            "m",
+            H5::PredType::NATIVE_DOUBLE,
+            dsp_m,
+            chunked(2, dim_m, compression_level)
+        )
+    );
+
+    // A contiguous field list is written in one go.
+    auto block = model.field_list().block();
+    if (!block.empty() && fields[0].size() == n_verts) {
+      ds_m.write(block.data(), H5::PredType::NATIVE_DOUBLE);
+      return;
+    }
+
+    // Otherwise write each field in to its own slab of rows.
+    hsize_t dim_memory[2] = {n_verts, 3};
+    H5::DataSpace dsp_memory(2, dim_memory);
+
+    for (size_t i = 0; i < fields.size(); ++i) {
+
+      if (fields[i].vectors().size() != n_verts) {
+        std::stringstream ss;
+        ss << "Field " << i << " does not have one vector per vertex.";
+        throw VTKHDFFileWriterException(ss.str());
+      }
+
+      hsize_t start[2] = {i * n_verts, 0};
+      dsp_m.selectHyperslab(H5S_SELECT_SET, dim_memory, start);
+      ds_m.write(fields[i].vectors().data(),
+                 H5::PredType::NATIVE_DOUBLE,
+                 dsp_memory,
+                 dsp_m);
+
+    }
+
+  }
+
+  /**
+   * Write the submesh indices as the cell data array `sid'.
+   * @param file the HDF5 file handle.
+   * @param model the model.
+   * @param compression_level the deflate level.
+   */
+  static void
+  write_cell_data(H5::H5File &file,
+                  const Model &model,
+                  unsigned compression_level) {
+
+    H5::Group grp_cell_data(file.createGroup("/VTKHDF/CellData"));
+
+    const auto &sml = model.mesh().sml();
+
+    hsize_t dim_sid[1] = {sml.size()};
+    H5::DataSpace dsp_sid(1, dim_sid);
+    H5::DataSet ds_sid(
+        grp_cell_data.createDataSet(
+            "sid",
+            H5::PredType::NATIVE_INT64,
+            dsp_sid,
+            chunked(1, dim_sid, compression_level)
+        )
+    );
+    ds_sid.write(sml.data(), H5::PredType::NATIVE_UINT64);
+
+  }
+
+  /**
+   * Write the `/VTKHDF/Steps' group, every step reuses the geometry and the
+   * cell data, only the point data offsets advance.
+   * @param file the HDF5 file handle.
+   * @param model the model.
+   */
+  static void
+  write_steps(H5::H5File &file, const Model &model) {
+
+    H5::Group grp_steps(file.createGroup("/VTKHDF/Steps"));
+
+    size_t n_steps = model.field_list().n_fields();
+    int64_t n_verts = (int64_t) model.mesh().vcl().size();
+
+    int n_steps_attr = (int) n_steps;
+    H5::DataSpace dsp_scalar(H5S_SCALAR);
+    H5::Attribute att_n_steps = grp_steps.createAttribute(
+        "NSteps",
+        H5::PredType::NATIVE_INT,
+        dsp_scalar
+    );
+    att_n_steps.write(H5::PredType::NATIVE_INT, &n_steps_attr);
+
+    std::vector<double> values(n_steps);
+    std::vector<int64_t> zeros(n_steps, 0);
+    std::vector<int64_t> ones(n_steps, 1);
+    std::vector<int64_t> m_offsets(n_steps);
+
+    for (size_t i = 0; i < n_steps; ++i) {
+      values[i] = (double) i;
+      m_offsets[i] = (int64_t) i * n_verts;
+    }
+
+    hsize_t dim_values[1] = {n_steps};
+    H5::DataSpace dsp_values(1, dim_values);
+    H5::DataSet ds_values(
+        grp_steps.createDataSet("Values", H5::PredType::NATIVE_DOUBLE, dsp_values)
+    );
+    ds_values.write(values.data(), H5::PredType::NATIVE_DOUBLE);
+
+    write_int64(grp_steps, "PartOffsets", zeros);
+    write_int64(grp_steps, "NumberOfParts", ones);
+    write_int64(grp_steps, "PointOffsets", zeros);
+
+    // One topology per step for unstructured grids.
+    hsize_t dim_topology[2] = {n_steps, 1};
+    H5::DataSpace dsp_topology(2, dim_topology);
+    H5::DataSet ds_cell_offsets(
+        grp_steps.createDataSet("CellOffsets", H5::PredType::NATIVE_INT64, dsp_topology)
+    );
+    ds_cell_offsets.write(zeros.data(), H5::PredType::NATIVE_INT64);
+    H5::DataSet ds_connectivity_offsets(
+        grp_steps.createDataSet("ConnectivityIdOffsets", H5::PredType::NATIVE_INT64, dsp_topology)
+    );
+    ds_connectivity_offsets.write(zeros.data(), H5::PredType::NATIVE_INT64);
+
+    H5::Group grp_point_data_offsets(grp_steps.createGroup("PointDataOffsets"));
+    write_int64(grp_point_data_offsets, "m", m_offsets);
+
+    H5::Group grp_cell_data_offsets(grp_steps.createGroup("CellDataOffsets"));
+    write_int64(grp_cell_data_offsets, "sid", zeros);
+
+  }
+
+};
+
+#endif //MFC_INCLUDE_WRITER_VTKHDF_HPP_
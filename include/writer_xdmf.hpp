@@ -5,6 +5,7 @@
 #ifndef MFC_INCLUDE_WRITER_XDMF_HPP_
 #define MFC_INCLUDE_WRITER_XDMF_HPP_
 
+#include <algorithm>
 #include <exception>
 #include <fstream>
 #include <string>
@@ -13,7 +14,10 @@
 #include <rapidxml_ext.hpp>
 
 #include "aliases.hpp"
+#include "index_width.hpp"
 #include "model.hpp"
+#include "precision.hpp"
+#include "surface.hpp"
 
 class XDMFFileWriterException : std::exception {
 
@@ -52,16 +56,130 @@ class XDMFFileWriter {
 
   /**
    * Function that will write a file.
+   * @param file_name the name of the XDMF file.
+   * @param hdf5_file_name the name of the HDF5 file that holds the data.
+   * @param model the model.
+   * @param surface if not null, also add a grid of the model's surface (which
+   *                must have been written to the HDF5 file).
+   * @param precision the precision that coordinates and fields were stored
+   *                  with in the HDF5 file.
    */
   static void
   write(const std::string &file_name,
         const std::string &hdf5_file_name,
-        const Model &model) {
+        const Model &model,
+        const Surface *surface = nullptr,
+        Precision precision = Precision::DOUBLE) {
+
+    std::string float_precision = std::to_string(precision_bytes(precision));
+    std::string dim_no_of_verts_x3 = std::to_string(model.mesh().vcl().size()) + " 3";
+
+    write_document(
+        file_name, hdf5_file_name, model, model.field_list().fields().size(), surface, precision,
+        [&](rapidxml::xml_document<> &doc, size_t time_index) {
+
+          // A step's field is the data set `/fields/field<i>/vectors'.
+          std::stringstream ss_field;
+          ss_field << hdf5_file_name << ":/fields/field" << time_index << "/vectors";
+          auto *data_item = doc.allocate_node(rapidxml::node_element, "DataItem", doc.allocate_string(ss_field.str().c_str()));
+          data_item->append_attribute(doc.allocate_attribute("Format", "HDF"));
+          data_item->append_attribute(doc.allocate_attribute("DataType", "Float"));
+          data_item->append_attribute(doc.allocate_attribute("Precision", doc.allocate_string(float_precision.c_str())));
+          data_item->append_attribute(doc.allocate_attribute("Dimensions", doc.allocate_string(dim_no_of_verts_x3.c_str())));
+
+          return data_item;
+
+        }
+    );
+
+  }
+
+  /**
+   * Function that will write a file for a time series whose fields are the
+   * slices of one [n_steps, n_vertices, 3] data set (e.g. the virtual data
+   * set of a stitched file, see `FieldStitcher'): each step's field is a
+   * hyperslab of it.
+   * @param file_name the name of the XDMF file.
+   * @param hdf5_file_name the name of the HDF5 file that holds the data.
+   * @param model the model (only its mesh is used).
+   * @param n_steps the number of steps.
+   * @param series_path the path of the series data set in the HDF5 file.
+   * @param precision the precision that coordinates and fields were stored
+   *                  with in the HDF5 file.
+   */
+  static void
+  write_series(const std::string &file_name,
+               const std::string &hdf5_file_name,
+               const Model &model,
+               size_t n_steps,
+               const std::string &series_path,
+               Precision precision = Precision::DOUBLE) {
+
+    size_t n_vertices = model.mesh().vcl().size();
+
+    std::string float_precision = std::to_string(precision_bytes(precision));
+    std::string dim_no_of_verts_x3 = std::to_string(n_vertices) + " 3";
+    std::string dim_series = std::to_string(n_steps) + " " + dim_no_of_verts_x3;
+    std::string series = hdf5_file_name + ":" + series_path;
+
+    write_document(
+        file_name, hdf5_file_name, model, n_steps, nullptr, precision,
+        [&](rapidxml::xml_document<> &doc, size_t time_index) {
+
+          using namespace rapidxml;
+
+          auto *data_item = doc.allocate_node(node_element, "DataItem");
+          data_item->append_attribute(doc.allocate_attribute("ItemType", "HyperSlab"));
+          data_item->append_attribute(doc.allocate_attribute("Dimensions", doc.allocate_string(dim_no_of_verts_x3.c_str())));
+
+          // Start, stride and count of the step's slice.
+          std::string selection = std::to_string(time_index) + " 0 0 1 1 1 1 " + dim_no_of_verts_x3;
+          auto *selection_item = doc.allocate_node(node_element, "DataItem", doc.allocate_string(selection.c_str()));
+          selection_item->append_attribute(doc.allocate_attribute("Dimensions", "3 3"));
+          selection_item->append_attribute(doc.allocate_attribute("Format", "XML"));
+          data_item->append_node(selection_item);
+
+          auto *series_item = doc.allocate_node(node_element, "DataItem", doc.allocate_string(series.c_str()));
+          series_item->append_attribute(doc.allocate_attribute("Format", "HDF"));
+          series_item->append_attribute(doc.allocate_attribute("DataType", "Float"));
+          series_item->append_attribute(doc.allocate_attribute("Precision", doc.allocate_string(float_precision.c_str())));
+          series_item->append_attribute(doc.allocate_attribute("Dimensions", doc.allocate_string(dim_series.c_str())));
+          data_item->append_node(series_item);
+
+          return data_item;
+
+        }
+    );
+
+  }
+
+ private:
+
+  /**
+   * Write a document with a temporal collection of one grid per step.
+   * @param file_name the name of the XDMF file.
+   * @param hdf5_file_name the name of the HDF5 file that holds the data.
+   * @param model the model.
+   * @param n_steps the number of steps.
+   * @param surface if not null, also add a grid of the model's surface.
+   * @param precision the precision of the stored coordinates and fields.
+   * @param field_item creates the DataItem node of a step's field, given the
+   *                   document and the step.
+   */
+  template<typename FieldItem>
+  static void
+  write_document(const std::string &file_name,
+                 const std::string &hdf5_file_name,
+                 const Model &model,
+                 size_t n_steps,
+                 const Surface *surface,
+                 Precision precision,
+                 FieldItem field_item) {
 
     using namespace rapidxml;
 
     std::string nodes_per_element = "4";
-    std::string precision = "8";
+    std::string float_precision = std::to_string(precision_bytes(precision));
     std::string format = "HDF";
     std::string dtype_float = "Float";
     std::string dtype_uint = "UInt";
@@ -102,6 +220,10 @@ class XDMFFileWriter {
 
     std::string magnetizations = ss_magnetizations.str();
 
+    // The widths of the (narrowest) integer types used by the HDF5 file.
+    std::string element_precision = std::to_string(element_index_bytes(model.mesh()));
+    std::string submesh_precision = std::to_string(submesh_index_bytes(model.mesh()));
+
     xml_document<> doc;
 
     // Create a declaration node.
@@ -124,10 +246,9 @@ class XDMFFileWriter {
     mesh_grid->append_attribute(doc.allocate_attribute("CollectionType", "Temporal"));
     domain->append_node(mesh_grid);
 
-    size_t time_index = 0;
-    std::vector<std::string> time_indices(model.field_list().fields().size());
-    std::vector<std::string> vector_fields_paths(model.field_list().fields().size());
-    for (const auto &field : model.field_list().fields()) {
+    // A mesh without fields still gets one (geometry only) step.
+    std::vector<std::string> time_indices(std::max<size_t>(n_steps, 1));
+    for (size_t time_index = 0; time_index < std::max<size_t>(n_steps, 1); ++time_index) {
 
       // Create Xdmf/Domain/Grid/Grid node
       xml_node <> *field_grid = doc.allocate_node(rapidxml::node_element, "Grid");
@@ -147,8 +268,8 @@ class XDMFFileWriter {
       // Create Xdmf/Domain/Grid/Grid/Topology/DataItem node
       xml_node <> *topo_data_item = doc.allocate_node(node_element, "DataItem", mesh_elements.c_str());
       topo_data_item->append_attribute(doc.allocate_attribute("Format", "HDF"));
-      topo_data_item->append_attribute(doc.allocate_attribute("DataType", "Int"));
-      topo_data_item->append_attribute(doc.allocate_attribute("Precision", "8"));
+      topo_data_item->append_attribute(doc.allocate_attribute("DataType", "UInt"));
+      topo_data_item->append_attribute(doc.allocate_attribute("Precision", element_precision.c_str()));
       topo_data_item->append_attribute(doc.allocate_attribute("Dimensions", dim_no_of_elems_x4.c_str()));
       topology->append_node(topo_data_item);
       //topo_data_items.push_back(topo_data_item);
@@ -163,7 +284,7 @@ class XDMFFileWriter {
       xml_node <> *geom_data_item = doc.allocate_node(node_element, "DataItem", mesh_vertices.c_str());
       geom_data_item->append_attribute(doc.allocate_attribute("Format", "HDF"));
       geom_data_item->append_attribute(doc.allocate_attribute("DataType", "Float"));
-      geom_data_item->append_attribute(doc.allocate_attribute("Precision", "8"));
+      geom_data_item->append_attribute(doc.allocate_attribute("Precision", float_precision.c_str()));
       geom_data_item->append_attribute(doc.allocate_attribute("Dimensions", dim_no_of_verts_x3.c_str()));
       geometry->append_node(geom_data_item);
 
@@ -177,11 +298,13 @@ class XDMFFileWriter {
       // Create /Xdmf/Domain/Grid/Grid/Attribute/DataItem
       xml_node<> *attr_sid_data_item = doc.allocate_node(node_element, "DataItem", mesh_submesh.c_str());
       attr_sid_data_item->append_attribute(doc.allocate_attribute("Format", "HDF"));
-      attr_sid_data_item->append_attribute(doc.allocate_attribute("DataType", "Int"));
-      attr_sid_data_item->append_attribute(doc.allocate_attribute("Precision", "8"));
+      attr_sid_data_item->append_attribute(doc.allocate_attribute("DataType", "UInt"));
+      attr_sid_data_item->append_attribute(doc.allocate_attribute("Precision", submesh_precision.c_str()));
       attr_sid_data_item->append_attribute(doc.allocate_attribute("Dimensions", dim_no_of_elems.c_str()));
       attribute_sid->append_node(attr_sid_data_item);
 
+      if (n_steps == 0) break;
+
       // Create /Xdmf/Domain/Grid/Grid/Time
       time_indices[time_index] = std::to_string(time_index);
       xml_node <> *time = doc.allocate_node(node_element, "Time");
@@ -196,18 +319,12 @@ class XDMFFileWriter {
       field_grid->append_node(attribute_field);
 
       // Create /Xdmf/Domain/Grid/Grid/Attribute/DataItem
-      std::stringstream ss_field;
-      ss_field << hdf5_file_name << ":/fields/field" << time_index << "/vectors";
-      vector_fields_paths[time_index] = ss_field.str();
-      xml_node <> *attr_field_data_item = doc.allocate_node(node_element, "DataItem", vector_fields_paths[time_index].c_str());
-      attr_field_data_item->append_attribute(doc.allocate_attribute("Format", "HDF"));
-      attr_field_data_item->append_attribute(doc.allocate_attribute("DataType", "Float"));
-      attr_field_data_item->append_attribute(doc.allocate_attribute("Precision", "8"));
-      attr_field_data_item->append_attribute(doc.allocate_attribute("Dimensions", dim_no_of_verts_x3.c_str()));
-      attribute_field->append_node(attr_field_data_item);
+      attribute_field->append_node(field_item(doc, time_index));
 
-      time_index = time_index + 1;
+    }
 
+    if (surface != nullptr) {
+      write_surface_grid(doc, domain, hdf5_file_name, model, *surface, precision);
     }
 
     // Print the XML document to a string
@@ -224,6 +341,112 @@ class XDMFFileWriter {
 
   }
 
+  /**
+   * Add a temporal collection of Triangle-topology grids over the surface
+   * datasets to the document's domain.
+   * @param doc the XML document.
+   * @param domain the document's /Xdmf/Domain node.
+   * @param hdf5_file_name the name of the HDF5 file that holds the data.
+   * @param model the model.
+   * @param surface the surface of the model's mesh.
+   * @param precision the precision of the stored coordinates and fields.
+   */
+  static void
+  write_surface_grid(rapidxml::xml_document<> &doc,
+                     rapidxml::xml_node<> *domain,
+                     const std::string &hdf5_file_name,
+                     const Model &model,
+                     const Surface &surface,
+                     Precision precision) {
+
+    using namespace rapidxml;
+
+    // Strings are allocated from the document, so they live as long as it.
+    auto str = [&doc](const std::string &s) {
+      return doc.allocate_string(s.c_str());
+    };
+
+    std::string float_precision = std::to_string(precision_bytes(precision));
+    std::string n_tris = std::to_string(surface.triangles.size());
+    std::string n_verts = std::to_string(surface.vertex_map.size());
+
+    // Create Xdmf/Domain/Grid node
+    xml_node<> *surface_grid = doc.allocate_node(node_element, "Grid");
+    surface_grid->append_attribute(doc.allocate_attribute("Name", "surface"));
+    surface_grid->append_attribute(doc.allocate_attribute("GridType", "Collection"));
+    surface_grid->append_attribute(doc.allocate_attribute("CollectionType", "Temporal"));
+    domain->append_node(surface_grid);
+
+    size_t n_fields = model.field_list().fields().size();
+    for (size_t time_index = 0; time_index < std::max<size_t>(n_fields, 1); ++time_index) {
+
+      // Create Xdmf/Domain/Grid/Grid node
+      xml_node<> *field_grid = doc.allocate_node(node_element, "Grid");
+      field_grid->append_attribute(doc.allocate_attribute("Name", "surface"));
+      field_grid->append_attribute(doc.allocate_attribute("GridType", "Uniform"));
+      surface_grid->append_node(field_grid);
+
+      // Create Xdmf/Domain/Grid/Grid/Topology node
+      xml_node<> *topology = doc.allocate_node(node_element, "Topology");
+      topology->append_attribute(doc.allocate_attribute("TopologyType", "Triangle"));
+      topology->append_attribute(doc.allocate_attribute("NumberOfElements", str(n_tris)));
+      topology->append_attribute(doc.allocate_attribute("NodesPerElement", "3"));
+      field_grid->append_node(topology);
+
+      xml_node<> *topo_data_item = doc.allocate_node(
+          node_element, "DataItem", str(hdf5_file_name + ":/surface/triangles")
+      );
+      topo_data_item->append_attribute(doc.allocate_attribute("Format", "HDF"));
+      topo_data_item->append_attribute(doc.allocate_attribute("DataType", "UInt"));
+      topo_data_item->append_attribute(
+          doc.allocate_attribute("Precision", str(std::to_string(index_bytes(surface.vertex_map.size()))))
+      );
+      topo_data_item->append_attribute(doc.allocate_attribute("Dimensions", str(n_tris + " 3")));
+      topology->append_node(topo_data_item);
+
+      // Create Xdmf/Domain/Grid/Grid/Geometry node
+      xml_node<> *geometry = doc.allocate_node(node_element, "Geometry");
+      geometry->append_attribute(doc.allocate_attribute("GeometryType", "XYZ"));
+      field_grid->append_node(geometry);
+
+      xml_node<> *geom_data_item = doc.allocate_node(
+          node_element, "DataItem", str(hdf5_file_name + ":/surface/vertices")
+      );
+      geom_data_item->append_attribute(doc.allocate_attribute("Format", "HDF"));
+      geom_data_item->append_attribute(doc.allocate_attribute("DataType", "Float"));
+      geom_data_item->append_attribute(doc.allocate_attribute("Precision", str(float_precision)));
+      geom_data_item->append_attribute(doc.allocate_attribute("Dimensions", str(n_verts + " 3")));
+      geometry->append_node(geom_data_item);
+
+      if (n_fields == 0) break;
+
+      // Create /Xdmf/Domain/Grid/Grid/Time
+      xml_node<> *time = doc.allocate_node(node_element, "Time");
+      time->append_attribute(doc.allocate_attribute("Value", str(std::to_string(time_index))));
+      field_grid->append_node(time);
+
+      // Create /Xdmf/Domain/Grid/Grid/Attribute
+      xml_node<> *attribute_field = doc.allocate_node(node_element, "Attribute");
+      attribute_field->append_attribute(doc.allocate_attribute("Name", "m"));
+      attribute_field->append_attribute(doc.allocate_attribute("AttributeType", "Vector"));
+      attribute_field->append_attribute(doc.allocate_attribute("Center", "Node"));
+      field_grid->append_node(attribute_field);
+
+      std::stringstream ss_field;
+      ss_field << hdf5_file_name << ":/surface/fields/field" << time_index << "/vectors";
+      xml_node<> *attr_field_data_item = doc.allocate_node(
+          node_element, "DataItem", str(ss_field.str())
+      );
+      attr_field_data_item->append_attribute(doc.allocate_attribute("Format", "HDF"));
+      attr_field_data_item->append_attribute(doc.allocate_attribute("DataType", "Float"));
+      attr_field_data_item->append_attribute(doc.allocate_attribute("Precision", str(float_precision)));
+      attr_field_data_item->append_attribute(doc.allocate_attribute("Dimensions", str(n_verts + " 3")));
+      attribute_field->append_node(attr_field_data_item);
+
+    }
+
+  }
+
 };
 
 #endif //MFC_INCLUDE_WRITER_XDMF_HPP_
\ No newline at end of file
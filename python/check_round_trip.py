@@ -0,0 +1,239 @@
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import zlib
+
+import h5py
+import numpy as np
+
+
+failures = []
+
+
+def check(condition, message):
+
+    print(("ok      " if condition else "FAILED  ") + message)
+    if not condition:
+        failures.append(message)
+
+
+def read_mmf(file_name):
+
+    # The reference model, as written to the .mmf file.
+    with h5py.File(file_name, "r") as mmf:
+        mesh = mmf["mesh"]
+        fields = mmf["fields"]
+        n_fields = len([name for name in fields if name.startswith("field")])
+        return {
+            "vertices": mesh["vertices"][()],
+            "elements": mesh["elements"][()],
+            "submesh": mesh["submesh"][()],
+            "fields": np.array([fields["field%d" % i]["vectors"][()] for i in range(n_fields)]),
+        }
+
+
+def check_npy(prefix, model):
+
+    for name in ("vertices", "elements", "submesh", "fields"):
+        array = np.load(prefix + "_" + name + ".npy", mmap_mode="r")
+        check(np.array_equal(array, model[name]), "npy: " + name)
+
+
+def check_npz(file_name, model):
+
+    with np.load(file_name) as npz:
+        check(sorted(npz.files) == ["elements", "fields", "submesh", "vertices"], "npz: members")
+        for name in ("vertices", "elements", "submesh", "fields"):
+            check(np.array_equal(npz[name], model[name]), "npz: " + name)
+
+
+def read_ovf(file_name):
+
+    with open(file_name, "rb") as fin:
+        data = fin.read()
+
+    begin = data.index(b"# Begin: Data Binary 8\n") + len(b"# Begin: Data Binary 8\n")
+    header = {}
+    for line in data[:begin].decode("ascii").splitlines():
+        key, _, value = line[2:].partition(": ")
+        header[key] = value
+
+    n = [int(header[axis + "nodes"]) for axis in "xyz"]
+    check_value = np.frombuffer(data, "<f8", 1, begin)[0]
+    values = np.frombuffer(data, "<f8", 3 * n[0] * n[1] * n[2], begin + 8).reshape(n[2], n[1], n[0], 3)
+    end = begin + 8 + values.nbytes
+
+    return header, check_value, values, data[end:]
+
+
+def check_ovf(prefix, model):
+
+    vertices = model["vertices"]
+    for i, field in enumerate(model["fields"]):
+        header, check_value, values, tail = read_ovf("%s_%d.ovf" % (prefix, i))
+        name = "ovf %d: " % i
+        check("OOMMF OVF 2.0" in header and header["valuedim"] == "3", name + "header")
+        check(check_value == 123456789012345.0, name + "check value")
+        check(tail == b"\n# End: Data Binary 8\n# End: Segment\n", name + "trailer")
+
+        # The grid covers the mesh.
+        lo = np.array([float(header[axis + "min"]) for axis in "xyz"])
+        hi = np.array([float(header[axis + "max"]) for axis in "xyz"])
+        check(np.all(lo <= vertices.min(axis=0)) and np.all(vertices.max(axis=0) <= hi), name + "extent")
+
+        # Cells in the mesh interpolate (are a convex combination of) vertex
+        # vectors, cells outside it are zero.
+        inside = np.any(values != 0.0, axis=3)
+        lo, hi = field.min(axis=0), field.max(axis=0)
+        bounded = np.all((values[inside] >= lo - 1e-12) & (values[inside] <= hi + 1e-12))
+        check(inside.any() and bounded, name + "values")
+
+
+def read_vtu(file_name):
+
+    with open(file_name, "rb") as fin:
+        data = fin.read()
+
+    xml, _, appended = data.partition(b'<AppendedData encoding="raw">')
+    appended = appended[appended.index(b"_") + 1:]
+    compressed = b"vtkZLibDataCompressor" in xml
+
+    types = {"Float64": "<f8", "Int64": "<i8", "UInt8": "u1"}
+    arrays = {}
+    for attributes in re.findall(rb"<DataArray ([^>]*)/>", xml):
+        attributes = dict(re.findall(r'(\w+)="([^"]*)"', attributes.decode("ascii")))
+        offset = int(attributes["offset"])
+        if compressed:
+            n_blocks = int(np.frombuffer(appended, "<u8", 1, offset)[0])
+            header = np.frombuffer(appended, "<u8", 3 + n_blocks, offset)
+            start = offset + 8 * len(header)
+            raw = b""
+            for size in header[3:]:
+                raw += zlib.decompress(appended[start:start + int(size)])
+                start += int(size)
+        else:
+            size = int(np.frombuffer(appended, "<u8", 1, offset)[0])
+            raw = appended[offset + 8:offset + 8 + size]
+        array = np.frombuffer(raw, types[attributes["type"]])
+        components = int(attributes.get("NumberOfComponents", "1"))
+        arrays[attributes.get("Name", "points")] = array.reshape(-1, components) if components > 1 else array
+
+    return arrays
+
+
+def check_pvtu(file_name, model):
+
+    with open(file_name) as fin:
+        sources = re.findall(r'Source="([^"]*)"', fin.read())
+
+    # Pieces hold consecutive runs of elements, over their own vertices.
+    index = {tuple(vertex): i for i, vertex in enumerate(model["vertices"])}
+    elements, submesh, fields = [], [], [[] for _ in model["fields"]]
+    for source in sources:
+        piece = read_vtu(os.path.join(os.path.dirname(file_name), source))
+        global_ids = np.array([index.get(tuple(point), -1) for point in piece["points"]])
+        check(np.all(global_ids >= 0), "pvtu: " + source + " points")
+        if np.any(global_ids < 0):
+            continue
+        elements.append(global_ids[piece["connectivity"].reshape(-1, 4)])
+        submesh.append(piece["sid"])
+        check(np.all(piece["types"] == 10) and np.array_equal(piece["offsets"], 4 * np.arange(1, len(piece["sid"]) + 1)),
+              "pvtu: " + source + " cells")
+        for i in range(len(fields)):
+            check(np.array_equal(piece["field%d" % i], model["fields"][i][global_ids]),
+                  "pvtu: " + source + " field%d" % i)
+
+    check(np.array_equal(np.concatenate(elements), model["elements"]), "pvtu: elements")
+    check(np.array_equal(np.concatenate(submesh), model["submesh"]), "pvtu: submesh")
+
+
+def patran_card(packet, id, iv, kc, n=(0, 0, 0, 0, 0)):
+
+    # A packet header card (I2, 8I8).
+    return "%2d%8d%8d%8d" % (packet, id, iv, kc) + "".join("%8d" % i for i in n) + "\n"
+
+
+def write_patran(file_name, model, sparse):
+
+    # Write the model's mesh as a Patran neutral file: nodes numbered
+    # 1, 2, ..., n and submesh ids as property ids or, if `sparse', nodes
+    # numbered 10, 13, 16, ... in reverse order and submesh ids as material
+    # configuration ids.
+    vertices, elements, submesh = model["vertices"], model["elements"], model["submesh"]
+    order = np.arange(len(vertices))[::-1] if sparse else np.arange(len(vertices))
+    node_ids = 10 + 3 * np.arange(len(vertices)) if sparse else 1 + np.arange(len(vertices))
+
+    with open(file_name, "w") as fout:
+        fout.write(patran_card(25, 0, 0, 1) + "check_round_trip\n")
+        fout.write(patran_card(26, 0, 0, 1, (len(vertices), len(elements), 1, 0, 0)) + "01-Jan-26   00:00:00\n")
+        for i in order:
+            fout.write(patran_card(1, node_ids[i], 0, 2))
+            fout.write("%16.9E%16.9E%16.9E\n" % tuple(vertices[i]))
+            fout.write("1G       6       0       0  000000\n")
+        for i, (element, sid) in enumerate(zip(elements, submesh)):
+            fout.write(patran_card(2, i + 1, 5, 2))
+            fout.write("%8d%8d%8d%8d\n" % ((4, sid, 0, 0) if sparse else (4, 0, sid, 0)))
+            fout.write("%8d%8d%8d%8d\n" % tuple(node_ids[element]))
+        fout.write(patran_card(99, 0, 0, 1))
+
+
+def check_patran(tec2hdf5, directory, model):
+
+    for sparse in (False, True):
+
+        name = "patran (%s): " % ("sparse node ids" if sparse else "dense node ids")
+        write_patran(os.path.join(directory, "mesh.pat"), model, sparse)
+        subprocess.run([tec2hdf5, os.path.join(directory, "mesh.pat"), os.path.join(directory, "mesh.mmf"),
+                        os.path.join(directory, "mesh.xdmf")], check=True, stdout=subprocess.DEVNULL)
+        mesh = read_mmf(os.path.join(directory, "mesh.mmf"))
+
+        # Vertices are read in file order, at the precision they were written.
+        order = np.arange(len(model["vertices"]))[::-1] if sparse else np.arange(len(model["vertices"]))
+        vertices = np.array([[float("%16.9E" % x) for x in vertex] for vertex in model["vertices"][order]])
+        position = np.argsort(order)
+
+        check(np.array_equal(mesh["vertices"], vertices), name + "vertices")
+        check(np.array_equal(mesh["elements"], position[model["elements"]]), name + "elements")
+        check(np.array_equal(mesh["submesh"], model["submesh"]), name + "submesh")
+        check(len(mesh["fields"]) == 0, name + "no fields")
+
+
+def main():
+
+    parser = argparse.ArgumentParser(
+        description="Convert a file with every byte level output of tec2hdf5 & check that each reads back as the "
+                    ".mmf file's model, then check that the mesh reads back from a Patran neutral file.")
+    parser.add_argument("tec2hdf5", help="the tec2hdf5 executable.")
+    parser.add_argument("input", help="the input MERRILL Tecplot file, e.g. test-meshes/single-zone-0001.tec.")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as directory:
+
+        def path(name):
+            return os.path.join(directory, name)
+
+        for compress in ([], ["--compress"]):
+            subprocess.run([args.tec2hdf5, args.input, path("model.mmf"), path("model.xdmf"),
+                            "--npy", path("model"), "--npz", path("model.npz"), "--ovf", path("model"),
+                            "--ovf-cells", "16", "--pvtu", path("model.pvtu"), "--pieces", "3"] + compress,
+                           check=True, stdout=subprocess.DEVNULL)
+
+            model = read_mmf(path("model.mmf"))
+            if not compress:
+                check_npy(path("model"), model)
+                check_npz(path("model.npz"), model)
+                check_ovf(path("model"), model)
+            print("PVTU" + (" (compressed)" if compress else ""))
+            check_pvtu(path("model.pvtu"), model)
+
+        check_patran(args.tec2hdf5, directory, model)
+
+    print("%d checks failed" % len(failures) if failures else "All checks passed")
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,29 @@
+import numpy as np
+
+
+def main():
+
+    # Arrays written with `tec2hdf5 ... --npy single' are memory mapped, no
+    # data is read until it is used.
+    vertices = np.load("single_vertices.npy", mmap_mode="r")
+    print("Mesh vertices")
+    print(vertices)
+
+    elements = np.load("single_elements.npy", mmap_mode="r")
+    print("Mesh elements")
+    print(elements)
+
+    submesh_indices = np.load("single_submesh.npy", mmap_mode="r")
+    print("Mesh submesh indices")
+    print(submesh_indices)
+
+    # Fields are stacked as [n_fields, n_verts, 3].
+    fields = np.load("single_fields.npy", mmap_mode="r")
+    print(fields.shape)
+
+    for field in fields:
+        print(field)
+
+
+if __name__ == "__main__":
+    main()
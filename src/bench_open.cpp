@@ -0,0 +1,239 @@
+//
+// Created by Lesleis Nagy on 18/10/2026.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <args.hxx>
+
+#include "loader_micromag.hpp"
+#include "writer_micromag.hpp"
+
+/**
+ * Create a model over an n x n x n grid of vertices (each cube split in to
+ * six tetrahedra) with a number of fields.
+ * @param n the number of vertices along each side.
+ * @param n_fields the number of fields.
+ * @return the model.
+ */
+Model grid_model(size_t n, size_t n_fields) {
+
+  v_list vcl;
+  for (size_t k = 0; k < n; ++k) {
+    for (size_t j = 0; j < n; ++j) {
+      for (size_t i = 0; i < n; ++i) {
+        vcl.push_back({double(i), double(j), double(k)});
+      }
+    }
+  }
+
+  auto index = [n](size_t i, size_t j, size_t k) { return i + n * (j + n * k); };
+
+  tet_list til;
+  for (size_t k = 0; k + 1 < n; ++k) {
+    for (size_t j = 0; j + 1 < n; ++j) {
+      for (size_t i = 0; i + 1 < n; ++i) {
+        size_t c[8] = {index(i, j, k), index(i + 1, j, k), index(i + 1, j + 1, k), index(i, j + 1, k),
+                       index(i, j, k + 1), index(i + 1, j, k + 1), index(i + 1, j + 1, k + 1), index(i, j + 1, k + 1)};
+        til.push_back({c[0], c[1], c[2], c[6]});
+        til.push_back({c[0], c[2], c[3], c[6]});
+        til.push_back({c[0], c[3], c[7], c[6]});
+        til.push_back({c[0], c[7], c[4], c[6]});
+        til.push_back({c[0], c[4], c[5], c[6]});
+        til.push_back({c[0], c[5], c[1], c[6]});
+      }
+    }
+  }
+
+  sm_list sml(til.size(), 1);
+
+  FieldList field_list(n_fields, vcl.size());
+  for (size_t f = 0; f < n_fields; ++f) {
+    auto vectors = field_list.fields()[f].vectors();
+    for (size_t v = 0; v < vectors.size(); ++v) vectors[v] = {1.0, double(f), double(v)};
+  }
+
+  return {Mesh(std::move(vcl), std::move(til), std::move(sml)), std::move(field_list)};
+
+}
+
+/**
+ * Drop a file's pages from the page cache, so that the next open is cold.
+ * @param file_name the name of the file.
+ */
+void drop_cache(const std::string &file_name) {
+
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) return;
+  ::fdatasync(fd);
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+
+}
+
+/**
+ * Retrieve the number of read system calls this process has made, a proxy
+ * for round trips to a parallel file system.
+ */
+size_t read_calls() {
+
+  std::ifstream fin("/proc/self/io");
+  std::string key;
+  size_t value;
+  while (fin >> key >> value) {
+    if (key == "syscr:") return value;
+  }
+
+  return 0;
+
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+}
+
+/**
+ * Compares the time to write, open and read a first field from a file with
+ * many fields, for a number of file format and metadata layout settings, and
+ * the time to read the mesh & first field in to single precision buffers.
+ */
+int main(int argc, char *argv[]) {
+
+  args::ArgumentParser
+      parser("Benchmark opening .mmf files with many fields under different HDF5 layouts.");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::ValueFlag<size_t>
+      n_fields(parser, "fields", "the number of fields (default: 5000).", {"fields"}, 5000);
+  args::ValueFlag<size_t>
+      n_side(parser, "n", "the number of grid vertices along each side (default: 6).", {"side"}, 6);
+  args::ValueFlag<size_t>
+      n_repeats(parser, "repeats", "the number of timed opens per setting (default: 5).", {"repeats"}, 5);
+  args::ValueFlag<std::string>
+      directory(parser, "dir", "the directory for the files (default: the working directory).", {"dir"}, ".");
+
+  try {
+    parser.ParseCLI(argc, argv);
+  }
+  catch (args::Help &e) {
+    std::cout << parser;
+    return 0;
+  }
+  catch (args::ParseError &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  Model model = grid_model(args::get(n_side), args::get(n_fields));
+
+  HDF5FileOptions latest;
+  latest.latest_format = true;
+
+  HDF5FileOptions paged = latest;
+  paged.page_size = 64 * 1024;
+
+  HDF5FileOptions paged_buffered = paged;
+  paged_buffered.page_buffer_size = 4 * 1024 * 1024;
+
+  std::vector<std::pair<std::string, HDF5FileOptions>> settings = {
+      {"default", HDF5FileOptions()},
+      {"latest", latest},
+      {"latest+paged", paged},
+      {"latest+paged+buffer", paged_buffered},
+      {"tuned", HDF5FileOptions::tuned()}
+  };
+
+  std::cout << model.field_list().n_fields() << " fields of " << model.mesh().vcl().size() << " vertices, "
+            << "file pages dropped before each of " << args::get(n_repeats) << " opens (median)" << std::endl;
+  std::cout << std::left << std::setw(22) << "setting"
+            << std::right << std::setw(12) << "size (MiB)"
+            << std::setw(12) << "write (s)"
+            << std::setw(12) << "open (ms)"
+            << std::setw(15) << "1st read (ms)"
+            << std::setw(16) << "last read (ms)"
+            << std::setw(16) << "f32 mesh (ms)"
+            << std::setw(8) << "reads" << std::endl;
+
+  std::string last = "/fields/field" + std::to_string(model.field_list().n_fields() - 1) + "/vectors";
+  fv_list vectors(model.mesh().vcl().size());
+
+  for (const auto &[name, options] : settings) {
+
+    std::string file_name = args::get(directory) + "/bench_" + name + ".mmf";
+
+    auto start = std::chrono::steady_clock::now();
+    MicromagFileWriter::write(file_name, model, Precision::DOUBLE, "", options);
+    double write_time = seconds_since(start);
+
+    std::vector<double> open_times, first_times, last_times, into_times;
+    size_t reads = 0;
+    for (size_t r = 0; r < args::get(n_repeats); ++r) {
+
+      drop_cache(file_name);
+
+      {
+        size_t reads_before = read_calls();
+        start = std::chrono::steady_clock::now();
+        H5::H5File file(file_name, H5F_ACC_RDONLY, H5::FileCreatPropList::DEFAULT, options.access_properties());
+        H5::Group grp_fields = file.openGroup("/fields");
+        open_times.push_back(seconds_since(start));
+
+        file.openDataSet("/fields/field0/vectors").read(vectors.data(), H5::PredType::NATIVE_DOUBLE);
+        first_times.push_back(seconds_since(start));
+
+        file.openDataSet(last).read(vectors.data(), H5::PredType::NATIVE_DOUBLE);
+        last_times.push_back(seconds_since(start));
+        reads = read_calls() - reads_before;
+      }
+
+      // The mesh & first field, read straight in to caller owned single
+      // precision / 32-bit buffers (as a renderer would).
+      drop_cache(file_name);
+
+      start = std::chrono::steady_clock::now();
+      ModelShape shape = MicromagFileLoader::shape(file_name, options);
+      std::vector<float> vertices(3 * shape.n_vertices), field(3 * shape.n_vertices);
+      std::vector<uint32_t> elements(4 * shape.n_elements), submesh(shape.n_elements);
+      ModelBuffers<float, uint32_t> buffers;
+      buffers.vertices = StridedSpan<float>(std::span<float>(vertices), 3);
+      buffers.elements = StridedSpan<uint32_t>(std::span<uint32_t>(elements), 4);
+      buffers.submesh = submesh;
+      buffers.fields.emplace_back(std::span<float>(field), 3);
+      MicromagFileLoader::read_into(file_name, buffers);
+      into_times.push_back(seconds_since(start));
+
+    }
+
+    auto median = [](std::vector<double> &times) {
+      std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+      return 1000.0 * times[times.size() / 2];
+    };
+
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed
+              << std::setw(12) << std::setprecision(2) << double(std::filesystem::file_size(file_name)) / (1 << 20)
+              << std::setw(12) << std::setprecision(3) << write_time
+              << std::setw(12) << std::setprecision(3) << median(open_times)
+              << std::setw(15) << std::setprecision(3) << median(first_times)
+              << std::setw(16) << std::setprecision(3) << median(last_times)
+              << std::setw(16) << std::setprecision(3) << median(into_times)
+              << std::setw(8) << reads << std::endl;
+
+    std::filesystem::remove(file_name);
+
+  }
+
+  return 0;
+
+}
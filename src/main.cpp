@@ -2,28 +2,599 @@
 // Created by L. Nagy on 28/06/2023.
 //
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <string>
+#include <unordered_map>
 
 #include <args.hxx>
 
+#include "arena.hpp"
+#include "field_stitcher.hpp"
+#include "geometry_cache.hpp"
+#include "loader_micromag.hpp"
+#include "loader_micromag_series.hpp"
+#include "loader_patran.hpp"
 #include "loader_tecplot.hpp"
+#include "mesh_quality.hpp"
+#include "mesh_registry.hpp"
+#include "mesh_validator.hpp"
+#include "precision.hpp"
+#include "reorder.hpp"
 #include "writer_micromag.hpp"
+#include "writer_micromag_series.hpp"
+#include "writer_numpy.hpp"
+#include "writer_ovf.hpp"
+#include "writer_pvtu.hpp"
+#include "writer_vtkhdf.hpp"
 #include "writer_xdmf.hpp"
 
+/**
+ * Retrieve true if a file name ends with an extension.
+ * @param file_name the name of the file.
+ * @param ext the extension, e.g. ".mmf".
+ */
+bool has_extension(const std::string &file_name, const std::string &ext) {
+
+  return file_name.size() >= ext.size()
+      && file_name.compare(file_name.size() - ext.size(), ext.size(), ext) == 0;
+
+}
+
+/**
+ * Retrieve true if a file is read as a MERRILL Tecplot file (see
+ * `read_model').
+ * @param file_name the name of the file.
+ */
+bool is_tecplot(const std::string &file_name) {
+
+  return !has_extension(file_name, ".pat")
+      && !has_extension(file_name, ".neu")
+      && !has_extension(file_name, ".mmf");
+
+}
+
+/**
+ * Retrieve the precision to store coordinates & fields on disk with, as given
+ * by a `--precision' flag (double if not given).
+ * @param flag the flag.
+ * @return the precision.
+ * @throws args::ValidationError if the flag does not name a precision.
+ */
+Precision storage_precision_of(args::ValueFlag<std::string> &flag) {
+
+  if (!flag) return Precision::DOUBLE;
+
+  try {
+    return precision(args::get(flag));
+  }
+  catch (PrecisionException &e) {
+    throw args::ValidationError(e.what());
+  }
+
+}
+
+/**
+ * Read a model, the loader is chosen by the input file's extension: Patran
+ * neutral files (`*.pat', `*.neu') are read as meshes, micromagnetic model
+ * files (`*.mmf') as written by this tool, anything else is read as a MERRILL
+ * Tecplot file.
+ * @param file_name the name of the input file.
+ * @param registry if given, the mesh is shared with earlier loads of the same
+ *                 mesh.
+ * @param resource the memory resource for the loader's temporaries.
+ * @return the model.
+ */
+Model read_model(const std::string &file_name,
+                 MeshRegistry *registry = nullptr,
+                 std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+
+  if (has_extension(file_name, ".pat") || has_extension(file_name, ".neu")) {
+    return PatranLoader::read(file_name, registry);
+  }
+
+  if (has_extension(file_name, ".mmf")) {
+    return MicromagFileLoader::read(file_name, registry);
+  }
+
+  return TecplotFileLoader::read(file_name, registry, resource);
+
+}
+
+/**
+ * Report the quality of a mesh, with its vertices loaded in to a given
+ * layout: a Tecplot file's vertices are copied from the loader's own (SoA)
+ * lists, other files' from the mesh's vertex list.
+ * @param file_name the name of the input file.
+ * @param n_bins the number of histogram bins.
+ * @return the quality report.
+ */
+template<VectorLayout Layout>
+QualityReport quality_report(const std::string &file_name, size_t n_bins) {
+
+  if (is_tecplot(file_name)) {
+    TecplotData data = TecplotFileLoader::read_data(file_name);
+    return MeshQuality::analyse(VectorArray<Layout>(data.get_vertex_view()),
+                                data.get_elements(),
+                                data.get_submesh_idxs(),
+                                n_bins);
+  }
+
+  Model model = read_model(file_name);
+  const Mesh &mesh = model.mesh();
+
+  return MeshQuality::analyse(VectorArray<Layout>(mesh.vcl()), mesh.til(), mesh.sml(), n_bins);
+
+}
+
+/**
+ * The `quality' subcommand: print per-submesh tetrahedron quality statistics.
+ * @param argc the number of arguments (starting with `quality').
+ * @param argv the arguments.
+ * @return the exit code.
+ */
+int quality_main(int argc, char *argv[]) {
+
+  args::ArgumentParser
+      parser("Report the quality of a mesh's tetrahedra, per submesh.");
+  parser.Prog("tec2hdf5 quality");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::Positional<std::string>
+      input_file(parser, "input", "the input MERRILL Tecplot, Patran or .mmf file.");
+  args::ValueFlag<size_t>
+      n_bins(parser, "bins", "the number of histogram bins (default: 20).", {"bins"}, 20);
+  args::Flag
+      histograms(parser, "histograms", "also print the histograms.", {"histograms"});
+  std::unordered_map<std::string, VectorLayout> layouts{
+      {"aos", VectorLayout::AOS}, {"soa", VectorLayout::SOA}, {"aosoa8", VectorLayout::AOSOA8}
+  };
+  args::MapFlag<std::string, VectorLayout>
+      layout(parser, "layout", "the layout to load the vertices in to: aos, soa (default) or aosoa8.", {"layout"},
+             layouts, VectorLayout::SOA);
+
+  try {
+    parser.ParseCLI(argc, argv);
+  }
+  catch (args::Help &e) {
+    std::cout << parser;
+    return 0;
+  }
+  catch (args::ParseError &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  if (!input_file) {
+    std::cerr << "Required input file." << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  std::cout << "Input file: " << args::get(input_file) << std::endl;
+
+  QualityReport report;
+  switch (args::get(layout)) {
+    case VectorLayout::AOS:
+      report = quality_report<VectorLayout::AOS>(args::get(input_file), args::get(n_bins));
+      break;
+    case VectorLayout::SOA:
+      report = quality_report<VectorLayout::SOA>(args::get(input_file), args::get(n_bins));
+      break;
+    case VectorLayout::AOSOA8:
+      report = quality_report<VectorLayout::AOSOA8>(args::get(input_file), args::get(n_bins));
+      break;
+  }
+  report.print(std::cout, args::get(histograms));
+
+  return 0;
+
+}
+
+/**
+ * The `stitch' subcommand: combine the fields of many .mmf files that share a
+ * mesh in to one time series file (and XDMF file), without copying data.
+ * @param argc the number of arguments (starting with `stitch').
+ * @param argv the arguments.
+ * @return the exit code.
+ */
+int stitch_main(int argc, char *argv[]) {
+
+  args::ArgumentParser
+      parser("Stitch the fields of .mmf files that share a mesh in to one (virtual) time series.");
+  parser.Prog("tec2hdf5 stitch");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::Positional<std::string>
+      output_hdf5(parser, "output_hdf5", "the output HDF5 file.");
+  args::Positional<std::string>
+      output_xdmf(parser, "output_xdmf", "the output XDMF file.");
+  args::PositionalList<std::string>
+      input_files(parser, "inputs", "the input .mmf files, in step order.");
+
+  try {
+    parser.ParseCLI(argc, argv);
+  }
+  catch (args::Help &e) {
+    std::cout << parser;
+    return 0;
+  }
+  catch (args::ParseError &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  if (!output_hdf5 || !output_xdmf || !input_files) {
+    std::cerr << "Required output HDF5 & XDMF files and input files." << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  std::cout << "Output HDF5 file: " << args::get(output_hdf5) << std::endl;
+  std::cout << "Output XDMF file: " << args::get(output_xdmf) << std::endl;
+
+  StitchSummary summary = FieldStitcher::stitch(args::get(output_hdf5), args::get(input_files));
+  std::cout << "Stitched " << summary.n_steps << " steps of " << summary.n_vertices << " vertices" << std::endl;
+
+  Model model = MicromagFileLoader::read(args::get(input_files).front());
+  XDMFFileWriter::write_series(args::get(output_xdmf),
+                               args::get(output_hdf5),
+                               model,
+                               summary.n_steps,
+                               FieldStitcher::SERIES,
+                               summary.precision);
+
+  return 0;
+
+}
+
+/**
+ * The `repack' subcommand: rewrite a .mmf file (e.g. at single precision)
+ * out of core, through file backed arrays in a scratch directory, so that
+ * models larger than memory can be converted.
+ * @param argc the number of arguments (starting with `repack').
+ * @param argv the arguments.
+ * @return the exit code.
+ */
+int repack_main(int argc, char *argv[]) {
+
+  args::ArgumentParser
+      parser("Rewrite a .mmf file out of core, for models that do not fit in memory.");
+  parser.Prog("tec2hdf5 repack");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::Positional<std::string>
+      input_file(parser, "input", "the input .mmf file.");
+  args::Positional<std::string>
+      output_hdf5(parser, "output_hdf5", "the output HDF5 file.");
+  args::ValueFlag<std::string>
+      storage_precision(parser, "precision", "store coordinates & fields on disk as single or double (default) precision (models are always held as doubles in memory).", {"precision"});
+  args::ValueFlag<std::string>
+      scratch(parser, "dir", "the directory for the file backed arrays (default: <output_hdf5>.scratch).", {"scratch"});
+  args::ValueFlag<size_t>
+      rows_per_block(parser, "rows", "the no. of rows copied per block (default: 1048576).", {"rows-per-block"}, size_t{1} << 20);
+
+  Precision file_precision = Precision::DOUBLE;
+  try {
+    parser.ParseCLI(argc, argv);
+    file_precision = storage_precision_of(storage_precision);
+    if (args::get(rows_per_block) == 0) {
+      throw args::ValidationError("The --rows-per-block must be at least 1.");
+    }
+  }
+  catch (args::Help &e) {
+    std::cout << parser;
+    return 0;
+  }
+  catch (args::ParseError &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+  catch (args::ValidationError &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  if (!input_file || !output_hdf5) {
+    std::cerr << "Required input & output HDF5 file." << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  std::filesystem::path scratch_dir = scratch ? args::get(scratch) : args::get(output_hdf5) + ".scratch";
+  std::filesystem::create_directories(scratch_dir);
+
+  std::cout << "Input file: " << args::get(input_file) << std::endl;
+  std::cout << "Output HDF5 file: " << args::get(output_hdf5) << std::endl;
+
+  MappedModel model = MicromagFileLoader::read_mapped(args::get(input_file), scratch_dir.string(),
+                                                      args::get(rows_per_block));
+  std::cout << "Vertices: " << model.vcl.size() << ", elements: " << model.til.size()
+            << ", fields: " << model.fields.size() << std::endl;
+
+  MicromagFileWriter::write_mapped(args::get(output_hdf5), model, args::get(rows_per_block), file_precision);
+
+  // Drop the backing files (and the scratch directory, if that leaves it
+  // empty).
+  std::error_code ec;
+  for (const auto *path : {&model.vcl.path(), &model.til.path(), &model.sml.path(),
+                           &model.vertex_ids.path(), &model.element_ids.path()}) {
+    if (!path->empty()) std::filesystem::remove(*path, ec);
+  }
+  for (const auto &field : model.fields) std::filesystem::remove(field.path(), ec);
+  std::filesystem::remove(scratch_dir, ec);
+
+  return 0;
+
+}
+
+/**
+ * The `watch' subcommand: follow a .mmf time series while it is being written
+ * (e.g. by `tec2hdf5 --swmr'), printing the mean of each field as it is
+ * appended, until no field has been appended for a while.
+ * @param argc the number of arguments (starting with `watch').
+ * @param argv the arguments.
+ * @return the exit code.
+ */
+int watch_main(int argc, char *argv[]) {
+
+  args::ArgumentParser
+      parser("Follow the fields of a .mmf time series while it is being written.");
+  parser.Prog("tec2hdf5 watch");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::Positional<std::string>
+      input_file(parser, "input", "the input .mmf file (with a '/fields/series' data set).");
+  args::ValueFlag<size_t>
+      timeout(parser, "seconds", "stop after no new field for this long (default: 10).", {"timeout"}, 10);
+  args::ValueFlag<size_t>
+      interval(parser, "ms", "the time between checks for new fields (default: 500).", {"interval"}, 500);
+
+  try {
+    parser.ParseCLI(argc, argv);
+    if (args::get(interval) == 0) {
+      throw args::ValidationError("The --interval must be at least 1 ms.");
+    }
+  }
+  catch (args::Help &e) {
+    std::cout << parser;
+    return 0;
+  }
+  catch (args::ParseError &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+  catch (args::ValidationError &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  if (!input_file) {
+    std::cerr << "Required input file." << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  std::cout << "Input file: " << args::get(input_file) << std::endl;
+
+  MicromagSeriesReader reader(args::get(input_file));
+  std::cout << "Vertices: " << reader.mesh()->vcl().size() << ", elements: " << reader.mesh()->til().size()
+            << std::endl;
+
+  // Print the fields that are already there, then each run of new ones.
+  size_t n_read = 0;
+  do {
+    FieldList field_list = reader.read(n_read, reader.n_steps() - n_read);
+    for (const auto &field : field_list.fields()) {
+      fv mean = {0.0, 0.0, 0.0};
+      for (const auto &vector : field.vectors()) {
+        for (size_t c = 0; c < 3; ++c) mean[c] += vector[c];
+      }
+      double n = double(std::max<size_t>(field.vectors().size(), 1));
+      std::cout << "Step " << n_read++ << ": mean (" << mean[0] / n << ", " << mean[1] / n << ", " << mean[2] / n
+                << ")" << std::endl;
+    }
+  } while (reader.poll(std::chrono::seconds(args::get(timeout)), std::chrono::milliseconds(args::get(interval))) > 0);
+
+  std::cout << "Steps: " << n_read << std::endl;
+
+  return 0;
+
+}
+
+/**
+ * The `batch' subcommand: convert many input files, each to
+ * `<output_dir>/<name>.mmf' and `<output_dir>/<name>.xdmf'. The loaders'
+ * temporaries come from one arena that is reset between files, so that after
+ * the first (largest) file the conversion reuses the same memory throughout.
+ * Meshes are shared through a registry: inputs with the mesh of an earlier
+ * input (e.g. the snapshots of one run) hold one copy of it, which is only
+ * validated once.
+ * @param argc the number of arguments (starting with `batch').
+ * @param argv the arguments.
+ * @return the exit code.
+ */
+int batch_main(int argc, char *argv[]) {
+
+  args::ArgumentParser
+      parser("Convert many MERRILL Tecplot (or Patran, or .mmf) files to HDF5 & XDMF files.");
+  parser.Prog("tec2hdf5 batch");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::Positional<std::string>
+      output_dir(parser, "output_dir", "the output directory.");
+  args::PositionalList<std::string>
+      input_files(parser, "inputs", "the input files.");
+  args::ValueFlag<std::string>
+      storage_precision(parser, "precision", "store coordinates & fields on disk as single or double (default) precision (models are always held as doubles in memory).", {"precision"});
+  args::Flag
+      no_validate(parser, "no-validate", "skip the mesh validity checks.", {"no-validate"});
+  args::Flag
+      huge_pages(parser, "huge-pages", "back the loader's scratch arena with transparent huge pages.", {"huge-pages"});
+
+  Precision file_precision = Precision::DOUBLE;
+  try {
+    parser.ParseCLI(argc, argv);
+    file_precision = storage_precision_of(storage_precision);
+  }
+  catch (args::Help &e) {
+    std::cout << parser;
+    return 0;
+  }
+  catch (args::ParseError &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+  catch (args::ValidationError &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  if (!output_dir || !input_files) {
+    std::cerr << "Required output directory and input files." << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  std::filesystem::create_directories(args::get(output_dir));
+
+  Arena arena(size_t{64} << 20, huge_pages);
+
+  // The distinct (usable) meshes so far, kept alive so that the registry
+  // hands them to later inputs.
+  MeshRegistry registry;
+  std::vector<std::shared_ptr<const Mesh>> meshes;
+
+  for (const auto &input : args::get(input_files)) {
+
+    std::string name = std::filesystem::path(input).stem().string();
+    std::filesystem::path output_hdf5 = std::filesystem::path(args::get(output_dir)) / (name + ".mmf");
+    std::filesystem::path output_xdmf = std::filesystem::path(args::get(output_dir)) / (name + ".xdmf");
+
+    std::cout << "Input file: " << input << std::endl;
+
+    Model model = read_model(input, &registry, arena.resource());
+    std::cout << "Arena: " << arena.used() << " of " << arena.capacity() << " bytes" << std::endl;
+
+    // The loader's temporaries are gone, the model was allocated normally.
+    arena.reset();
+
+    if (std::find(meshes.begin(), meshes.end(), model.shared_mesh()) != meshes.end()) {
+      std::cout << "Mesh shared with an earlier input" << std::endl;
+    } else {
+      if (!no_validate) {
+        ValidationReport report = MeshValidator::validate(model.mesh());
+        report.print(std::cout);
+        if (!report.usable()) {
+          std::cerr << "The mesh has out of range vertex indices, skipping." << std::endl;
+          continue;
+        }
+      }
+      meshes.push_back(model.shared_mesh());
+    }
+
+    std::cout << "Output HDF5 file: " << output_hdf5.string() << std::endl;
+    MicromagFileWriter::write(output_hdf5.string(), model, file_precision);
+    XDMFFileWriter::write(output_xdmf.string(), output_hdf5.filename().string(), model, nullptr, file_precision);
+
+  }
+
+  std::cout << "Distinct meshes: " << meshes.size() << std::endl;
+
+  return 0;
+
+}
+
 int main(int argc, char *argv[]) {
 
+  if (argc > 1 && std::string(argv[1]) == "quality") {
+    return quality_main(argc - 1, argv + 1);
+  }
+
+  if (argc > 1 && std::string(argv[1]) == "stitch") {
+    return stitch_main(argc - 1, argv + 1);
+  }
+
+  if (argc > 1 && std::string(argv[1]) == "repack") {
+    return repack_main(argc - 1, argv + 1);
+  }
+
+  if (argc > 1 && std::string(argv[1]) == "watch") {
+    return watch_main(argc - 1, argv + 1);
+  }
+
+  if (argc > 1 && std::string(argv[1]) == "batch") {
+    return batch_main(argc - 1, argv + 1);
+  }
+
   args::ArgumentParser
-      parser("A small utility to convert MERRILL Tecplot files to HDF5.");
+      parser("A small utility to convert MERRILL Tecplot files to HDF5.",
+             "Use `tec2hdf5 quality <input>' to report the mesh quality, or `tec2hdf5 stitch "
+             "<output_hdf5> <output_xdmf> <inputs...>' to stitch .mmf files in to a time series, `tec2hdf5 batch "
+             "<output_dir> <inputs...>' to convert many files, `tec2hdf5 repack <input> <output_hdf5>' to "
+             "rewrite a .mmf file out of core, or `tec2hdf5 watch <input>' to follow a .mmf time series while it "
+             "is being written instead.");
   args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
   args::Positional<std::string>
-      input_file(parser, "input", "the input MERRILL file.");
+      input_file(parser, "input", "the input MERRILL Tecplot, Patran or .mmf file.");
   args::Positional<std::string>
       output_hdf5(parser, "output_hdf5", "the output HDF5 file.");
   args::Positional<std::string>
       output_xdmf(parser, "output_xdmf", "the output XDMF file (optional).");
+  args::ValueFlag<std::string>
+      output_vtkhdf(parser, "vtkhdf", "also write a VTKHDF file.", {"vtkhdf"});
+  args::ValueFlag<std::string>
+      output_npy(parser, "npy", "also write <npy>_{vertices,elements,submesh,fields}.npy files.", {"npy"});
+  args::ValueFlag<std::string>
+      output_npz(parser, "npz", "also write an uncompressed NumPy .npz file.", {"npz"});
+  args::ValueFlag<std::string>
+      output_ovf(parser, "ovf", "also resample the fields to <ovf>_<i>.ovf files.", {"ovf"});
+  args::ValueFlag<size_t>
+      ovf_cells(parser, "cells", "the no. of OVF cells along the longest side (default: 64).", {"ovf-cells"}, 64);
+  args::ValueFlag<std::string>
+      output_pvtu(parser, "pvtu", "also write a partitioned VTU/PVTU file set.", {"pvtu"});
+  args::ValueFlag<size_t>
+      pvtu_pieces(parser, "pieces", "the number of PVTU pieces (default: no. of threads).", {"pieces"}, 0);
+  args::ValueFlag<std::string>
+      reorder(parser, "strategy", "renumber vertices & elements: hilbert, morton or rcm.", {"reorder"});
+  args::Flag
+      output_geometry(parser, "geometry", "also store tet volumes & shape function gradients in the HDF5 file.", {"geometry"});
+  args::Flag
+      output_surface(parser, "surface", "also write the boundary surface (to the HDF5 & XDMF files).", {"surface"});
+  args::Flag
+      pvtu_compress(parser, "compress", "zlib compress the PVTU appended data.", {"compress"});
+  args::Flag
+      no_validate(parser, "no-validate", "skip the mesh validity checks.", {"no-validate"});
+  args::Flag
+      repair(parser, "repair", "re-orient inverted tetrahedra found by the validity checks.", {"repair"});
+  args::ValueFlag<std::string>
+      storage_precision(parser, "precision", "store coordinates & fields on disk as single or double (default) precision (models are always held as doubles in memory).", {"precision"});
+  args::ValueFlag<std::string>
+      mesh_store(parser, "dir", "store the mesh once in a shared mesh store directory & link to it.", {"mesh-store"});
+  args::Flag
+      latest_format(parser, "latest-format", "write the latest HDF5 file format (indexed groups, for many fields).", {"latest-format"});
+  args::ValueFlag<size_t>
+      page_size(parser, "bytes", "aggregate the HDF5 file's space in pages of this size (512 to 2^30, e.g. 65536).", {"page-size"}, 0);
+  args::ValueFlag<size_t>
+      metadata_cache(parser, "bytes", "the initial size of the HDF5 metadata cache while writing.", {"metadata-cache"}, 0);
+  args::Flag
+      swmr(parser, "swmr", "write a file that can be read while it is written (fields go to /fields/series; implies --latest-format).", {"swmr"});
+  args::ValueFlag<std::string>
+      validation_report(parser, "json", "also write the validity checks' report to a JSON file.", {"validation-report"});
 
+  Precision file_precision = Precision::DOUBLE;
   try {
     parser.ParseCLI(argc, argv);
+    file_precision = storage_precision_of(storage_precision);
+    if (page_size && (args::get(page_size) < 512 || args::get(page_size) > (size_t{1} << 30))) {
+      throw args::ValidationError("The --page-size must be from 512 bytes to 1 GiB.");
+    }
   }
   catch (args::Help &e) {
     std::cout << parser;
@@ -40,23 +611,140 @@ int main(int argc, char *argv[]) {
     return 1;
   }
 
+  HDF5FileOptions file_options;
+  file_options.latest_format = latest_format;
+  file_options.page_size = args::get(page_size);
+  file_options.metadata_cache_size = args::get(metadata_cache);
+
+  if (swmr && mesh_store) {
+    std::cerr << "The --swmr and --mesh-store options cannot be combined." << std::endl;
+    return 1;
+  }
+
+  // Read the input model, validating (and repairing) and reordering it if
+  // requested.
+  auto load_model = [&]() {
+    Model model = read_model(args::get(input_file));
+    if (!no_validate) {
+      ValidationReport report = MeshValidator::validate(model.mesh());
+      report.print(std::cout);
+      if (validation_report) {
+        std::ofstream fout(args::get(validation_report));
+        report.write_json(fout);
+      }
+      if (!report.usable()) {
+        std::cerr << "The mesh has out of range vertex indices, stopping." << std::endl;
+        std::exit(1);
+      }
+      if (repair && !report.inverted.empty()) {
+        std::cout << "Re-orienting " << report.inverted.size() << " tetrahedra" << std::endl;
+        model = Model(MeshValidator::reorient(model.mesh(), report), model.field_list());
+      }
+    }
+    if (reorder) {
+      std::cout << "Reordering: " << args::get(reorder) << std::endl;
+      model = MeshReorderer::reorder(model, reorder_strategy(args::get(reorder)));
+    }
+    return model;
+  };
+
+  // Write the HDF5 file, appending the fields one at a time if it is to be
+  // readable while it is written.
+  auto write_hdf5 = [&](const Model &model, const Surface *surface) {
+    if (swmr) {
+      MicromagSeriesWriter writer(args::get(output_hdf5), model, file_precision, surface, file_options);
+      for (const auto &field : model.field_list().fields()) writer.append(field);
+    } else if (surface) {
+      MicromagFileWriter::write(args::get(output_hdf5), model, *surface, file_precision, args::get(mesh_store),
+                                file_options);
+    } else {
+      MicromagFileWriter::write(args::get(output_hdf5), model, file_precision, args::get(mesh_store), file_options);
+    }
+  };
+
+  // Write the XDMF file for the HDF5 file's layout.
+  auto write_xdmf = [&](const Model &model, const Surface *surface) {
+    if (swmr) {
+      XDMFFileWriter::write_series(args::get(output_xdmf), args::get(output_hdf5), model,
+                                   model.field_list().n_fields(), MicromagSeriesWriter::SERIES, file_precision);
+    } else {
+      XDMFFileWriter::write(args::get(output_xdmf), args::get(output_hdf5), model, surface, file_precision);
+    }
+  };
+
+  // Write the optional outputs requested by flags.
+  auto write_extra_outputs = [&](const Model &model) {
+    if (output_geometry) {
+      std::cout << "Writing geometry cache to: " << args::get(output_hdf5) << std::endl;
+      GeometryCache::write(args::get(output_hdf5), GeometryCache(model.mesh()));
+    }
+    if (output_vtkhdf) {
+      std::cout << "Output VTKHDF file: " << args::get(output_vtkhdf) << std::endl;
+      VTKHDFFileWriter::write(args::get(output_vtkhdf), model);
+    }
+    if (output_npy) {
+      std::cout << "Output NumPy prefix: " << args::get(output_npy) << std::endl;
+      NumpyFileWriter::write_npy(args::get(output_npy), model);
+    }
+    if (output_npz) {
+      std::cout << "Output NumPy archive: " << args::get(output_npz) << std::endl;
+      NumpyFileWriter::write_npz(args::get(output_npz), model);
+    }
+    if (output_ovf) {
+      std::cout << "Output OVF prefix: " << args::get(output_ovf) << std::endl;
+      GridResampler resampler(
+          model.mesh(),
+          GridResampler::fit_grid(model.mesh(), args::get(ovf_cells))
+      );
+      std::cout << "Grid points inside mesh: " << resampler.n_located()
+                << " of " << resampler.grid().size() << std::endl;
+      resampler.resample_all(model.field_list(), [&](size_t i, const fv_list &values) {
+        std::stringstream ss;
+        ss << args::get(output_ovf) << "_" << i << ".ovf";
+        OVFFileWriter::write(ss.str(), resampler.grid(), values);
+      });
+    }
+    if (output_pvtu) {
+      std::cout << "Output PVTU file: " << args::get(output_pvtu) << std::endl;
+      PVTUFileWriter::write(args::get(output_pvtu),
+                            model,
+                            args::get(pvtu_pieces),
+                            args::get(pvtu_compress));
+    }
+  };
+
   if (input_file && output_hdf5 && output_xdmf) {
 
     std::cout << "Input file: " << args::get(input_file) << std::endl;
     std::cout << "Output HDF5 file: " << args::get(output_hdf5) << std::endl;
     std::cout << "Output XDMF file: " << args::get(output_xdmf) << std::endl;
 
-    Model model = TecplotFileLoader::read(args::get(input_file));
-    MicromagFileWriter::write(args::get(output_hdf5), model);
-    XDMFFileWriter::write(args::get(output_xdmf), args::get(output_hdf5), model);
+    Model model = load_model();
+    if (output_surface) {
+      Surface surface = SurfaceExtractor::extract(model.mesh());
+      std::cout << "Surface triangles: " << surface.triangles.size() << std::endl;
+      write_hdf5(model, &surface);
+      write_xdmf(model, &surface);
+    } else {
+      write_hdf5(model, nullptr);
+      write_xdmf(model, nullptr);
+    }
+    write_extra_outputs(model);
 
   } else if (input_file && output_hdf5) {
 
     std::cout << "Input file: " << args::get(input_file) << std::endl;
     std::cout << "Output HDF5 file: " << args::get(output_hdf5) << std::endl;
 
-    Model model = TecplotFileLoader::read(args::get(input_file));
-    MicromagFileWriter::write(args::get(output_hdf5), model);
+    Model model = load_model();
+    if (output_surface) {
+      Surface surface = SurfaceExtractor::extract(model.mesh());
+      std::cout << "Surface triangles: " << surface.triangles.size() << std::endl;
+      write_hdf5(model, &surface);
+    } else {
+      write_hdf5(model, nullptr);
+    }
+    write_extra_outputs(model);
 
   } else {
 